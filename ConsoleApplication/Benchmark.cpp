@@ -9,20 +9,35 @@
 #include "CryptoMiniSat/CryptoMiniSatSolver.h"
 #include "Gurobi/GurobiSolver.h"
 #include "LocalSolverSat/LocalSolverSat.h"
+#include "Partitioning/Algorithm/CommunityPartitioner.h"
 #include "Partitioning/Algorithm/DisconnectedPartitioner.h"
 #include "Partitioning/Algorithm/FastPartitioner.h"
 #include "Partitioning/Algorithm/GreedyPartitioner.h"
+#include "Partitioning/Algorithm/MultilevelPartitioner.h"
 #include "Partitioning/Algorithm/OnePointPartitioner.h"
+#include "Partitioning/Algorithm/TreeDecompositionPartitioner.h"
 #include "SolverPortfolio/SolverPortfolio.h"
 #include "Core/Utility/CNFParser.h"
+#include "Core/Utility/CostModel.h"
 #include "DummySolver.h"
 
 std::string GetHeader()
 {
-    return "time;problem;instance name;clauses;variables;density(C / V);avg clause length;min clause length;max clause length;avg number of variable occurences;min number of variable occurences;max number of variable occurences;CryptoMiniSat;CryptoMiniSat time;Gurobi;Gurobi time;LocalSolver;LocalSolver time;valid;";
+    // written for every solver in this order, see GetContent
+    const std::vector<std::string> statsColumns = {"time", "cpu time", "peak memory", "subproblems", "cut size", "process time", "cache hits", "conflicts"};
+
+    std::string ret = "time;problem;instance name;clauses;variables;used variables;density(C / V);avg clause length;min clause length;max clause length;avg number of variable occurences;min number of variable occurences;max number of variable occurences;";
+    for (std::string solver : {"CryptoMiniSat", "Gurobi", "LocalSolver"}) {
+        ret += solver + ";";
+        for (const auto& column : statsColumns) {
+            ret += solver + " " + column + ";";
+        }
+    }
+    ret += "valid;";
+    return ret;
 }
 
-std::string GetContent(const std::filesystem::path& path, const Problem& problem, const std::vector<SolvingResult>& results, const std::vector<std::chrono::milliseconds>& elapsed)
+std::string GetContent(const std::filesystem::path& path, const Problem& problem, const std::vector<SolvingResult>& results, const std::vector<SolveStats>& stats)
 {
     const char Separator = ';';
     std::stringstream ret;
@@ -50,6 +65,9 @@ std::string GetContent(const std::filesystem::path& path, const Problem& problem
     // variables
     ret << problem.GetNumberOfVariables() << Separator;
 
+    // used variables, the feature of CostModel and SolverSelector
+    ret << CostModel::GetFeatures(problem).variables << Separator;
+
     // density
     ret << problem.GetDensity() << Separator;
 
@@ -92,8 +110,15 @@ std::string GetContent(const std::filesystem::path& path, const Problem& problem
         }
         ret << Separator;
 
-        // elapsed
-        ret << elapsed[i].count() << Separator;
+        // statistics
+        ret << stats[i].wallTime.count() << Separator;
+        ret << stats[i].cpuTime.count() << Separator;
+        ret << stats[i].peakMemory << Separator;
+        ret << stats[i].subproblems << Separator;
+        ret << stats[i].cutSize << Separator;
+        ret << stats[i].processTime.count() << Separator;
+        ret << stats[i].cacheHits << Separator;
+        ret << stats[i].conflicts << Separator;
     }
 
     // valid
@@ -135,6 +160,27 @@ int Benchmark(std::string directory, std::string outputFile, OptionalTimeLimitMs
             solvers.push_back(s);
             s->SetPartitionSolver(std::make_shared<GurobiSolver>());
         }
+        {
+            auto s = std::make_shared<MultilevelPartitioner>();
+            solvers.push_back(s);
+            s->SetPartitionSolver(std::make_shared<CryptoMiniSatSolver>());
+        }
+        {
+            auto s = std::make_shared<CommunityPartitioner>();
+            solvers.push_back(s);
+            s->SetPartitionSolver(std::make_shared<CryptoMiniSatSolver>());
+        }
+        {
+            auto s = std::make_shared<MultilevelPartitioner>();
+            solvers.push_back(s);
+            s->SetPartitionSolver(std::make_shared<CryptoMiniSatSolver>());
+            s->SetRecursion([]() { return std::make_shared<MultilevelPartitioner>(); }, 20000);
+        }
+        {
+            auto s = std::make_shared<TreeDecompositionPartitioner>();
+            solvers.push_back(s);
+            s->SetPartitionSolver(std::make_shared<CryptoMiniSatSolver>());
+        }
         {
             auto s = std::make_shared<OnePointPartitioner>();
             solvers.push_back(s);
@@ -175,15 +221,13 @@ int Benchmark(std::string directory, std::string outputFile, OptionalTimeLimitMs
                 auto problem = ParseCNF(infile);
 
                 std::vector<SolvingResult> results;
-                std::vector<std::chrono::milliseconds> elapsed;
+                std::vector<SolveStats> stats;
                 for (auto solver : solvers) {
-                    auto start = std::chrono::steady_clock::now();
-
                     try {
-                        // solve
-                        results.push_back(solver->Solve(problem, timeLimitPerInstance).first);
-                        // measure time
-                        elapsed.push_back(std::chrono::duration_cast<std::chrono::milliseconds>(GetElapsed(start)));
+                        // solve & measure
+                        auto [solution, solveStats] = solver->SolveWithStats(problem, timeLimitPerInstance);
+                        results.push_back(solution.first);
+                        stats.push_back(solveStats);
 
                     } catch (std::exception e) {
                         // avoid early terminination of benchmark
@@ -192,7 +236,7 @@ int Benchmark(std::string directory, std::string outputFile, OptionalTimeLimitMs
                 }
 
                 // log
-                outfile << GetContent(instance.path(), problem, results, elapsed) << std::endl;
+                outfile << GetContent(instance.path(), problem, results, stats) << std::endl;
             }
         } catch (std::exception e) {
             // avoid early terminination of benchmark
@@ -3,7 +3,9 @@
 
 #include "pch.h"
 
+#include <algorithm>
 #include <iostream>
+#include <string>
 
 #include "Programs.h"
 
@@ -14,15 +16,31 @@ int main(int argc, char *argv[])
     //    return EXIT_SUCCESS;
     //}
 
+    // "--trace" writes instance/trace.json
+    auto trace = std::any_of(argv + 1, argv + argc, [](const char* argument) {
+        return std::string(argument) == "--trace";
+    });
+
 #if true
     // "instance/input.cnf" "instance/solution.txt"
-    //return SingleInstance({argv[1]}, {argv[2]}, {});
-    return SingleInstance("instance/input.cnf", "instance/solution.txt", std::chrono::milliseconds(1000 * 100));
-    //return SingleInstance("instance/input.cnf", "instance/solution.txt", {});
+    //return SingleInstance({argv[1]}, {argv[2]}, {}, trace);
+    return SingleInstance("instance/input.cnf", "instance/solution.txt", std::chrono::milliseconds(1000 * 100), trace);
+    //return SingleInstance("instance/input.cnf", "instance/solution.txt", {}, trace);
 #elif true
     // "C:\Test\woipv\test" "instance/solution.csv"
     //return Benchmark({argv[1]}, {argv[2]}, std::chrono::milliseconds(1000 * 100));
     return Benchmark("C:\\Test\\woipv\\test", "instance/solution.csv", std::chrono::milliseconds(1000 * 100));
+#elif false
+    // "instance/generated.cnf"
+    GeneratorSettings settings;
+    settings.type = InstanceType::Chain;
+    settings.numberOfVariables = 1000;
+    settings.numberOfComponents = 10;
+    settings.seed = 1;
+    return Generate("instance/generated.cnf", settings);
+#elif false
+    // "instance/solution.csv" "instance/selector.txt"
+    return TrainSelector("instance/solution.csv", "instance/selector.txt", SolverSelector::DefaultNeighbours);
 #else
     // "instance/input.cnf" "instance/output.cnf"
     //return VariableShift({argv[1]}, {argv[2]}, 0);
@@ -0,0 +1,23 @@
+#include "pch.h"
+#include "Programs.h"
+
+#include <fstream>
+#include <iostream>
+
+int Generate(std::string outputFile, const GeneratorSettings& settings)
+{
+    if (outputFile.rfind(".csv", outputFile.size() - 4) != -1) {
+        throw std::runtime_error("output must not be a csv file");
+    }
+
+    std::ofstream output(outputFile);
+    if (!output) {
+        std::cout << "Could not open output file (" << outputFile << ").";
+        return EXIT_FAILURE;
+    }
+
+    // streamed, the instance is never held in memory
+    WriteGeneratedCNF(settings, output);
+
+    return EXIT_SUCCESS;
+}
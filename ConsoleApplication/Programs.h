@@ -5,12 +5,29 @@
 #include "Core/Interfaces/SATSolver.h"
 #include "Core/Utility/TimeLimit.h"
 #include "Core/Types/Literal.h"
+#include "Core/Utility/InstanceGenerator.h"
+#include "Core/Utility/SolverSelector.h"
 
 int Benchmark(std::string directory, std::string outputFile, OptionalTimeLimitMs timeLimitPerInstance);
-int SingleInstance(std::string instance, std::string outputFile, OptionalTimeLimitMs timeLimit);
+/// <summary>
+/// Solves instance and writes the assignment to outputFile.
+/// With trace the phases of the solvers are written to instance/trace.json (open it in chrome://tracing).
+/// </summary>
+int SingleInstance(std::string instance, std::string outputFile, OptionalTimeLimitMs timeLimit, bool trace = false);
 
 /// <summary>
 /// Shifts the variables of instance.
 /// Shift may be negative but must be bigger than the smallest variable (negated).
 /// </summary>
 int VariableShift(std::string instance, std::string outputFile, Literal shift);
+
+/// <summary>
+/// Writes a synthetic instance (reproducible by its seed) to outputFile.
+/// </summary>
+int Generate(std::string outputFile, const GeneratorSettings& settings);
+
+
+/// <summary>
+/// Trains the solver selector of SolverPortfolio on the results of Benchmark and writes the model to outputFile.
+/// </summary>
+int TrainSelector(std::string benchmarkFile, std::string outputFile, size_t numberOfNeighbours);
\ No newline at end of file
@@ -6,7 +6,11 @@
 #include <sstream>
 
 #include "Core/Types/Assignment.h"
+#include "Core/Utility/CachingSolver.h"
 #include "Core/Utility/CNFParser.h"
+#include "Core/Utility/CostModel.h"
+#include "Core/Utility/SolverSelector.h"
+#include "Core/Utility/Trace.h"
 #include "Core/Interfaces/SATSolver.h"
 
 #include "SifferDP/SifferDPSolver.h"
@@ -15,12 +19,15 @@
 #include "LocalSolverSat/LocalSolverSat.h"
 #include "SolverPortfolio/SolverPortfolio.h"
 
+#include "Partitioning/Algorithm/CommunityPartitioner.h"
 #include "Partitioning/Algorithm/GreedyPartitioner.h"
 #include "Partitioning/Algorithm/DisconnectedPartitioner.h"
 #include "Partitioning/Algorithm/FastPartitioner.h"
+#include "Partitioning/Algorithm/MultilevelPartitioner.h"
 #include "Partitioning/Algorithm/OnePointPartitioner.h"
+#include "Partitioning/Algorithm/TreeDecompositionPartitioner.h"
 
-int SingleInstance(std::string instance, std::string outputFile, OptionalTimeLimitMs timeLimit)
+int SingleInstance(std::string instance, std::string outputFile, OptionalTimeLimitMs timeLimit, bool trace)
 {
     if (outputFile.rfind(".csv", outputFile.size() - 4) != -1) {
         throw std::runtime_error("output must not be a csv file");
@@ -32,6 +39,11 @@ int SingleInstance(std::string instance, std::string outputFile, OptionalTimeLim
         return EXIT_FAILURE;
     }
 
+    if (trace) {
+        // phases of the partitioners and solvers, open the file in chrome://tracing
+        Tracer::Enable();
+    }
+
     auto problem = ParseCNF(infile);
 
     std::shared_ptr<SATSolver> solver;
@@ -39,17 +51,46 @@ int SingleInstance(std::string instance, std::string outputFile, OptionalTimeLim
     solver = std::make_shared<CryptoMiniSatSolver>();
     // solver = std::make_shared<LocalSolverSat>();
     //solver = std::make_shared<SolverPortfolio>();
+    if (auto portfolio = std::dynamic_pointer_cast<SolverPortfolio>(solver)) {
+        // schedule per instance, trained by TrainSelector
+        std::ifstream model("instance/selector.txt");
+        if (model) {
+            portfolio->SetSelector(std::make_shared<SolverSelector>(SolverSelector::Load(model)));
+        }
+    }
+    // results of earlier runs and repeated subproblems
+    //solver = std::make_shared<CachingSolver>(solver, "CryptoMiniSat", std::make_shared<SolutionStore>("instance/cache"));
 
 #if tru // use partitioning
     //auto part = std::make_shared<FastPartitioner>();
     //auto part = std::make_shared<DisconnectedPartitioner>();
     //auto part = std::make_shared<GreedyPartitioner>();
+    //auto part = std::make_shared<MultilevelPartitioner>();
+    //auto part = std::make_shared<CommunityPartitioner>();
+    //auto part = std::make_shared<TreeDecompositionPartitioner>();
     auto part = std::make_shared<OnePointPartitioner>();
     part->SetPartitionSolver(solver);
+    // choose between partitioning and direct solving by the times of an earlier benchmark
+    std::ifstream benchmark("instance/solution.csv");
+    if (benchmark) {
+        try {
+            part->SetCostModel(std::make_shared<CostModel>(CostModel::Calibrate(benchmark, "CryptoMiniSat")));
+        } catch (std::runtime_error& e) {
+            std::cout << "cost model not calibrated: " << e.what() << std::endl;
+        }
+    }
     solver = part;
 #endif
 
-    auto[solvingResult, assignment] = solver->Solve(problem, timeLimit);
+    auto[solution, stats] = solver->SolveWithStats(problem, timeLimit);
+    auto[solvingResult, assignment] = solution;
+
+    if (Tracer::IsEnabled()) {
+        std::ofstream trace("instance/trace.json");
+        if (trace) {
+            Tracer::WriteChromeTrace(trace);
+        }
+    }
 
     // output result
     std::stringstream output;
@@ -79,6 +120,19 @@ int SingleInstance(std::string instance, std::string outputFile, OptionalTimeLim
 
     std::cout << output.str();
 
+    std::cout << std::endl << "wall " << stats.wallTime.count() << " ms, cpu " << stats.cpuTime.count() << " ms, peak memory "
+        << stats.peakMemory / (1024 * 1024) << " MB, subproblems " << stats.subproblems << ", cut size " << stats.cutSize
+        << ", process " << stats.processTime.count() << " ms, cache hits " << stats.cacheHits << ", conflicts " << stats.conflicts << std::endl;
+
+    if (auto partitioner = std::dynamic_pointer_cast<AbstractPartitioner>(solver)) {
+        auto hits = partitioner->GetCacheHits();
+        auto misses = partitioner->GetCacheMisses();
+        if (hits + misses > 0) {
+            std::cout << std::endl << "partition cache: " << hits << " hits, " << misses << " misses ("
+                << 100.0 * hits / (hits + misses) << "%)" << std::endl;
+        }
+    }
+
     // write result to file
     std::ofstream outfile(outputFile);
     if (!outfile) {
@@ -0,0 +1,33 @@
+#include "pch.h"
+#include "Programs.h"
+
+#include <fstream>
+#include <iostream>
+
+#include "Core/Utility/SolverSelector.h"
+#include "SolverPortfolio/SolverPortfolio.h"
+
+int TrainSelector(std::string benchmarkFile, std::string outputFile, size_t numberOfNeighbours)
+{
+    if (outputFile.rfind(".csv", outputFile.size() - 4) != -1) {
+        throw std::runtime_error("output must not be a csv file");
+    }
+
+    std::ifstream benchmark(benchmarkFile);
+    if (!benchmark) {
+        std::cout << "Could not open benchmark file (" << benchmarkFile << ").";
+        return EXIT_FAILURE;
+    }
+
+    auto selector = SolverSelector::Train(benchmark, SolverPortfolio::GetSolverNames(), numberOfNeighbours);
+
+    std::ofstream output(outputFile);
+    if (!output) {
+        std::cout << "Could not open output file (" << outputFile << ").";
+        return EXIT_FAILURE;
+    }
+    selector.Save(output);
+
+    std::cout << "trained on " << selector.GetNumberOfSamples() << " instances" << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -3,6 +3,10 @@
 
 #include <algorithm>
 #include <functional>
+#include <stdexcept>
+
+#include "Core/Utility/ResourceUsage.h"
+#include "Core/Utility/StatsCollector.h"
 
 std::vector<Solution> SATSolver::Solve(const std::vector<Problem>& problems, OptionalTimeLimitMs timeLimit)
 {
@@ -14,3 +18,83 @@ std::vector<Solution> SATSolver::Solve(const std::vector<Problem>& problems, Opt
     });
     return ret;
 }
+
+std::pair<Solution, SolveStats> SATSolver::SolveWithStats(const Problem& problem, OptionalTimeLimitMs timeLimit)
+{
+    auto enclosing = StatsCollector::GetCurrent();
+    auto collector = std::make_shared<StatsCollector>();
+    auto start = std::chrono::steady_clock::now();
+    auto usage = GetResourceUsage();
+
+    std::optional<Solution> solution;
+    {
+        StatsCollector::Scope scope(collector);
+        solution = Solve(problem, timeLimit);
+    }
+
+    auto stats = collector->Get();
+    auto end = GetResourceUsage();
+    stats.wallTime = std::chrono::duration_cast<std::chrono::milliseconds>(GetElapsed(start));
+    stats.cpuTime = end.cpuTime - usage.cpuTime;
+    stats.peakMemory = end.peakMemory;
+    if (enclosing) {
+        enclosing->Add(stats);
+    }
+    return {std::move(solution.value()), stats};
+}
+
+Projections SATSolver::EnumerateProjections(const Problem& problem, const std::vector<Variable>& variables, OptionalTimeLimitMs timeLimit)
+{
+    return EnumerateByBlocking(problem, variables, timeLimit, [this](const auto& p, auto t) {
+        return Solve(p, t);
+    });
+}
+
+Projections SATSolver::EnumerateByBlocking(const Problem& problem, const std::vector<Variable>& variables, OptionalTimeLimitMs timeLimit, const std::function<Solution(const Problem&, OptionalTimeLimitMs)>& solve)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    // only variables of the clauses are projected
+    std::vector<bool> used(static_cast<size_t>(problem.GetNumberOfVariables()) + 1, false);
+    for (const auto& clause : problem.GetClauses()) {
+        for (auto literal : clause) {
+            used[ToVariable(literal)] = true;
+        }
+    }
+    std::vector<Variable> projected;
+    for (auto variable : variables) {
+        if (used[variable]) {
+            // duplicates are projected once
+            used[variable] = false;
+            projected.push_back(variable);
+        }
+    }
+
+    Projections ret {SolvingResult::Unsatisfiable, {}};
+    auto clauses = problem.GetClauses();
+    while (true) {
+        auto solution = solve(Problem(problem.GetNumberOfVariables(), clauses), GetRemaining(timeLimit, start));
+        if (solution.first == SolvingResult::Undefined) {
+            ret.first = SolvingResult::Undefined;
+            return ret;
+        }
+        if (solution.first == SolvingResult::Unsatisfiable) {
+            return ret;
+        }
+        if (!solution.second) {
+            throw std::runtime_error("satisfiable solution without assignment");
+        }
+
+        Clause blocking;
+        for (auto variable : projected) {
+            blocking.push_back(solution.second->GetState(variable) == VariableState::True ? Negate(variable) : variable);
+        }
+        ret.first = SolvingResult::Satisfiable;
+        ret.second.push_back(std::move(solution.second.value()));
+        if (blocking.empty()) {
+            // nothing projected, one witness is enough
+            return ret;
+        }
+        clauses.push_back(std::move(blocking));
+    }
+}
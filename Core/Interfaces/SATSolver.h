@@ -1,10 +1,13 @@
 #pragma once
 
+#include <functional>
 #include <vector>
 
 #include "Core/DLLMakro.h"
 #include "Core/Types/Problem.h"
 #include "Core/Types/Solution.h"
+#include "Core/Types/Projections.h"
+#include "Core/Types/SolveStats.h"
 #include "Core/Utility/TimeLimit.h"
 
 /// <summary>
@@ -14,4 +17,36 @@ class CORE_API SATSolver {
 public:
     virtual Solution Solve(const Problem& problem, OptionalTimeLimitMs timeLimit) abstract;
     virtual std::vector<Solution> Solve(const std::vector<Problem>& problems, OptionalTimeLimitMs timeLimit);
+
+    /// <summary>
+    /// Solves and measures the time and memory of the solve.
+    /// The counters reported meanwhile (see StatsCollector) are collected, also from the tasks of the solve,
+    /// and added to the solve that encloses this one.
+    /// </summary>
+    /// <param name="problem"></param>
+    /// <param name="timeLimit"></param>
+    /// <returns></returns>
+    std::pair<Solution, SolveStats> SolveWithStats(const Problem& problem, OptionalTimeLimitMs timeLimit);
+
+    /// <summary>
+    /// Enumerates all assignments of the projection variables that can be extended to a model, one witness model each.
+    /// Projection variables that do not occur in the clauses are not projected.
+    /// The default implementation blocks every found projection and solves again (see EnumerateByBlocking).
+    /// </summary>
+    /// <param name="problem"></param>
+    /// <param name="variables">projection variables</param>
+    /// <param name="timeLimit"></param>
+    /// <returns>Unsatisfiable if there is no model</returns>
+    virtual Projections EnumerateProjections(const Problem& problem, const std::vector<Variable>& variables, OptionalTimeLimitMs timeLimit);
+
+    /// <summary>
+    /// Adds the negation of the projection of every model as a clause until the problem becomes unsatisfiable.
+    /// The number of solves is the number of projections plus one.
+    /// </summary>
+    /// <param name="problem"></param>
+    /// <param name="variables">projection variables</param>
+    /// <param name="timeLimit"></param>
+    /// <param name="solve">must report a complete model if satisfiable</param>
+    /// <returns></returns>
+    static Projections EnumerateByBlocking(const Problem& problem, const std::vector<Variable>& variables, OptionalTimeLimitMs timeLimit, const std::function<Solution(const Problem&, OptionalTimeLimitMs)>& solve);
 };
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+
+/// <summary>
+/// One witness model per satisfiable assignment of the projection variables.
+/// Undefined if the enumeration was interrupted, the witnesses found so far are still valid.
+/// </summary>
+using Projections = std::pair<SolvingResult, std::vector<Assignment>>;
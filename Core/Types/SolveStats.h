@@ -0,0 +1,57 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+/// <summary>
+/// Where the time and memory of one solve went.
+/// The times and the memory are measured around the whole solve (see SATSolver::SolveWithStats),
+/// the counters are reported by the solvers, decorators and partitioners involved (see StatsCollector).
+/// </summary>
+struct SolveStats {
+    std::chrono::milliseconds wallTime {0};
+    /// <summary>
+    /// user and kernel time of the process during the solve
+    /// </summary>
+    std::chrono::milliseconds cpuTime {0};
+    /// <summary>
+    /// peak resident memory of the process in bytes (high-water mark, not reset per solve)
+    /// </summary>
+    size_t peakMemory = 0;
+
+    /// <summary>
+    /// subproblems passed to a solver, summed over the nested partitioners
+    /// </summary>
+    size_t subproblems = 0;
+    /// <summary>
+    /// cut variables of the applied partitionings, summed over the nested partitioners
+    /// </summary>
+    size_t cutSize = 0;
+    /// <summary>
+    /// time spent in external solver processes
+    /// </summary>
+    std::chrono::milliseconds processTime {0};
+    /// <summary>
+    /// solution and partition cache hits
+    /// </summary>
+    size_t cacheHits = 0;
+    /// <summary>
+    /// conflicts as reported by the solvers that report them
+    /// </summary>
+    size_t conflicts = 0;
+
+    /// <summary>
+    /// Adds the counters of a nested solve, the measured times and the memory are kept.
+    /// </summary>
+    /// <param name="nested"></param>
+    /// <returns></returns>
+    SolveStats& operator+=(const SolveStats& nested)
+    {
+        subproblems += nested.subproblems;
+        cutSize += nested.cutSize;
+        processTime += nested.processTime;
+        cacheHits += nested.cacheHits;
+        conflicts += nested.conflicts;
+        return *this;
+    }
+};
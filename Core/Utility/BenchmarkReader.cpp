@@ -0,0 +1,77 @@
+#include "Core/stdafx.h"
+#include "BenchmarkReader.h"
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+static const char Separator = ';';
+
+static std::vector<std::string> SplitLine(const std::string& line)
+{
+    std::vector<std::string> fields;
+    std::stringstream stream(line);
+    std::string field;
+    while (std::getline(stream, field, Separator)) {
+        fields.push_back(field);
+    }
+    return fields;
+}
+
+BenchmarkReader::BenchmarkReader(std::istream& input) :
+    input(input)
+{
+}
+
+bool BenchmarkReader::Next()
+{
+    std::string line;
+    while (std::getline(input, line)) {
+        auto lineFields = SplitLine(line);
+        if (lineFields.empty()) {
+            continue;
+        }
+        if (lineFields[0] == "time") {
+            header = std::move(lineFields);
+            continue;
+        }
+        if (header.empty()) {
+            throw std::runtime_error("benchmark result without header");
+        }
+        fields = std::move(lineFields);
+        return true;
+    }
+    fields.clear();
+    return false;
+}
+
+std::optional<std::string> BenchmarkReader::GetField(const std::string& column) const
+{
+    auto it = std::find(header.begin(), header.end(), column);
+    if (it == header.end()) {
+        return {};
+    }
+    auto index = static_cast<size_t>(it - header.begin());
+    if (index >= fields.size()) {
+        return {};
+    }
+    return fields[index];
+}
+
+std::optional<double> BenchmarkReader::GetNumber(const std::string& column) const
+{
+    auto field = GetField(column);
+    if (!field) {
+        return {};
+    }
+    try {
+        size_t pos = 0;
+        auto value = std::stod(field.value(), &pos);
+        if (pos != field->size()) {
+            return {};
+        }
+        return value;
+    } catch (std::logic_error&) {
+        return {};
+    }
+}
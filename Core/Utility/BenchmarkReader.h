@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Core/DLLMakro.h"
+
+#include <istream>
+#include <optional>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// Reads the csv written by Benchmark row by row.
+/// Benchmark appends a header line per run and the solvers of the runs may differ,
+/// so the columns are looked up by name in the header of the current run.
+/// </summary>
+class CORE_API BenchmarkReader {
+private:
+    std::istream& input;
+    std::vector<std::string> header;
+    std::vector<std::string> fields;
+
+public:
+    /// <summary>
+    /// The stream must outlive the reader.
+    /// </summary>
+    /// <param name="input"></param>
+    explicit BenchmarkReader(std::istream& input);
+
+public:
+    /// <summary>
+    /// Moves to the next result row, header lines are consumed on the way.
+    /// Throws if a result row precedes the first header.
+    /// </summary>
+    /// <returns>false at the end of the input</returns>
+    bool Next();
+
+    /// <summary>
+    /// field of the current row
+    /// </summary>
+    /// <param name="column">name in the header</param>
+    /// <returns>none if the current run does not have the column or the row is too short</returns>
+    std::optional<std::string> GetField(const std::string& column) const;
+
+    /// <summary>
+    /// see GetField
+    /// </summary>
+    /// <param name="column"></param>
+    /// <returns>none if the field is missing or not a number</returns>
+    std::optional<double> GetNumber(const std::string& column) const;
+};
@@ -0,0 +1,258 @@
+#include "Core/stdafx.h"
+#include "BitSlicedSolver.h"
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
+#include "CompactedProblem.h"
+#include "Trace.h"
+
+static_assert(BitSlicedSolver::Lanes == 8, "the lane variables assume 8 words per block");
+
+/// <summary>
+/// variables 0..5 select the bit of a word, 6..8 the word of a block
+/// </summary>
+static const size_t WordVariables = 6;
+static const size_t LowVariables = WordVariables + 3;
+
+static const uint64_t Patterns[WordVariables] = {
+    0xAAAAAAAAAAAAAAAAull,
+    0xCCCCCCCCCCCCCCCCull,
+    0xF0F0F0F0F0F0F0F0ull,
+    0xFF00FF00FF00FF00ull,
+    0xFFFF0000FFFF0000ull,
+    0xFFFFFFFF00000000ull,
+};
+
+namespace {
+/// <summary>
+/// literals of a clause as (variable index, negated), split by the position of the variable
+/// </summary>
+struct SlicedClause {
+    std::vector<std::pair<size_t, bool>> low;
+    /// <summary>
+    /// constant within a block, the index is relative to LowVariables
+    /// </summary>
+    std::vector<std::pair<size_t, bool>> high;
+};
+}
+
+/// <summary>
+/// Evaluates the clauses on every block of assignments of a compacted problem.
+/// The index of an assignment is (block, word, bit), its bits are the values of the variables.
+/// </summary>
+/// <param name="local">compacted problem</param>
+/// <param name="timeLimit"></param>
+/// <param name="start"></param>
+/// <param name="visit">gets the satisfying assignments of a non-empty block as bits, returns false to stop</param>
+/// <returns>Satisfiable if visit stopped, Unsatisfiable if all blocks were visited, Undefined if the time ran out</returns>
+static SolvingResult Sweep(const Problem& local, OptionalTimeLimitMs timeLimit, std::chrono::steady_clock::time_point start, const std::function<bool(uint64_t, const BitSlicedSolver::Block&)>& visit)
+{
+    auto numberOfVariables = static_cast<size_t>(local.GetNumberOfVariables());
+    if (numberOfVariables > static_cast<size_t>(BitSlicedSolver::MaxVariables)) {
+        throw std::invalid_argument("too many variables for exhaustive enumeration");
+    }
+
+    // value of each low variable in every word of a block
+    std::vector<BitSlicedSolver::Block> lowValues(LowVariables);
+    for (size_t variable = 0; variable < LowVariables; variable++) {
+        for (size_t lane = 0; lane < BitSlicedSolver::Lanes; lane++) {
+            if (variable < WordVariables) {
+                lowValues[variable][lane] = Patterns[variable];
+            } else {
+                lowValues[variable][lane] = ((lane >> (variable - WordVariables)) & 1) ? ~0ull : 0;
+            }
+        }
+    }
+
+    // short clauses first, they empty the block sooner
+    std::vector<SlicedClause> clauses;
+    clauses.reserve(local.GetClauses().size());
+    for (const auto& clause : local.GetClauses()) {
+        if (clause.empty()) {
+            return SolvingResult::Unsatisfiable;
+        }
+        SlicedClause sliced;
+        for (auto literal : clause) {
+            auto index = static_cast<size_t>(ToVariable(literal) - FirstVariable);
+            if (index < LowVariables) {
+                sliced.low.emplace_back(index, !IsPositive(literal));
+            } else {
+                sliced.high.emplace_back(index - LowVariables, !IsPositive(literal));
+            }
+        }
+        clauses.push_back(std::move(sliced));
+    }
+    std::stable_sort(clauses.begin(), clauses.end(), [](const auto& l, const auto& r) {
+        return l.low.size() + l.high.size() < r.low.size() + r.high.size();
+    });
+
+    uint64_t numberOfBlocks = 1ull << (numberOfVariables > LowVariables ? numberOfVariables - LowVariables : 0);
+    for (uint64_t block = 0; block < numberOfBlocks; block++) {
+        if (block % 256 == 0 && !HasRemaining(timeLimit, start)) {
+            return SolvingResult::Undefined;
+        }
+
+        BitSlicedSolver::Block result;
+        result.fill(~0ull);
+        auto any = ~0ull;
+        for (const auto& clause : clauses) {
+            auto satisfied = std::any_of(clause.high.begin(), clause.high.end(), [block](const auto& literal) {
+                return static_cast<bool>((block >> literal.first) & 1) != literal.second;
+            });
+            if (satisfied) {
+                continue;
+            }
+
+            BitSlicedSolver::Block values {};
+            for (const auto& literal : clause.low) {
+                auto negation = literal.second ? ~0ull : 0;
+                const auto& variable = lowValues[literal.first];
+                for (size_t lane = 0; lane < BitSlicedSolver::Lanes; lane++) {
+                    values[lane] |= variable[lane] ^ negation;
+                }
+            }
+            any = 0;
+            for (size_t lane = 0; lane < BitSlicedSolver::Lanes; lane++) {
+                result[lane] &= values[lane];
+                any |= result[lane];
+            }
+            if (!any) {
+                break;
+            }
+        }
+        if (any && !visit(block, result)) {
+            return SolvingResult::Satisfiable;
+        }
+    }
+    return SolvingResult::Unsatisfiable;
+}
+
+/// <summary>
+/// assignment of a compacted problem from the index of Sweep
+/// </summary>
+/// <param name="numberOfVariables"></param>
+/// <param name="index"></param>
+/// <returns></returns>
+static Assignment CreateAssignment(Variable numberOfVariables, uint64_t index)
+{
+    Assignment assignment(numberOfVariables);
+    for (Variable variable = FirstVariable; variable <= numberOfVariables; variable++) {
+        auto state = ((index >> (variable - FirstVariable)) & 1) ? VariableState::True : VariableState::False;
+        assignment.SetState(variable, state);
+    }
+    return assignment;
+}
+
+Solution BitSlicedSolver::Solve(const Problem& problem, OptionalTimeLimitMs timeLimit)
+{
+    TraceSpan span("BitSliced", "solver");
+    auto start = std::chrono::steady_clock::now();
+
+    CompactedProblem compacted(problem);
+    const auto& local = compacted.GetProblem();
+
+    uint64_t index = 0;
+    auto result = Sweep(local, timeLimit, start, [&index](auto block, const auto& models) {
+        // first satisfying assignment of the block
+        size_t lane = 0;
+        while (models[lane] == 0) {
+            lane++;
+        }
+        size_t bit = 0;
+        while (((models[lane] >> bit) & 1) == 0) {
+            bit++;
+        }
+        index = (block << LowVariables) | (lane << WordVariables) | bit;
+        return false;
+    });
+    if (result != SolvingResult::Satisfiable) {
+        return {result, {}};
+    }
+    return {SolvingResult::Satisfiable, compacted.Expand(CreateAssignment(local.GetNumberOfVariables(), index))};
+}
+
+Projections BitSlicedSolver::EnumerateProjections(const Problem& problem, const std::vector<Variable>& variables, OptionalTimeLimitMs timeLimit)
+{
+    TraceSpan span("BitSliced projections", "solver");
+    auto start = std::chrono::steady_clock::now();
+
+    CompactedProblem compacted(problem);
+    const auto& local = compacted.GetProblem();
+
+    // position of every projected variable in the index of Sweep
+    std::vector<Variable> localVariables(static_cast<size_t>(problem.GetNumberOfVariables()) + 1, 0);
+    for (Variable variable = FirstVariable; variable <= local.GetNumberOfVariables(); variable++) {
+        localVariables[compacted.GetOriginalVariable(variable)] = variable;
+    }
+    std::vector<size_t> positions;
+    for (auto variable : variables) {
+        if (localVariables[variable] != 0) {
+            positions.push_back(static_cast<size_t>(localVariables[variable] - FirstVariable));
+            // duplicates are projected once
+            localVariables[variable] = 0;
+        }
+    }
+
+    // projection of the positions within a block, the high variables are added per block
+    std::vector<uint64_t> lowKeys(Lanes << WordVariables, 0);
+    for (size_t index = 0; index < lowKeys.size(); index++) {
+        for (size_t i = 0; i < positions.size(); i++) {
+            if (positions[i] < LowVariables && ((index >> positions[i]) & 1)) {
+                lowKeys[index] |= 1ull << i;
+            }
+        }
+    }
+
+    std::vector<bool> found(size_t(1) << positions.size(), false);
+    auto missing = found.size();
+    Projections ret {SolvingResult::Unsatisfiable, {}};
+    auto result = Sweep(local, timeLimit, start, [&](auto block, const auto& models) {
+        uint64_t highKey = 0;
+        for (size_t i = 0; i < positions.size(); i++) {
+            if (positions[i] >= LowVariables && ((block >> (positions[i] - LowVariables)) & 1)) {
+                highKey |= 1ull << i;
+            }
+        }
+        for (size_t lane = 0; lane < Lanes; lane++) {
+            auto word = models[lane];
+            for (size_t bit = 0; word != 0; bit++, word >>= 1) {
+                if ((word & 1) == 0) {
+                    continue;
+                }
+                auto index = (lane << WordVariables) | bit;
+                auto key = highKey | lowKeys[index];
+                if (found[key]) {
+                    continue;
+                }
+                found[key] = true;
+                ret.second.push_back(compacted.Expand(CreateAssignment(local.GetNumberOfVariables(), (block << LowVariables) | index)));
+                if (--missing == 0) {
+                    // every projection is extendable
+                    return false;
+                }
+            }
+        }
+        return true;
+    });
+    if (result == SolvingResult::Undefined) {
+        ret.first = SolvingResult::Undefined;
+    } else if (!ret.second.empty()) {
+        ret.first = SolvingResult::Satisfiable;
+    }
+    return ret;
+}
+
+Variable BitSlicedSolver::GetNumberOfUsedVariables(const Problem& problem)
+{
+    // proportional to the size of the clauses, the problem may be a small part of many variables
+    std::vector<Variable> variables;
+    for (const auto& clause : problem.GetClauses()) {
+        for (auto literal : clause) {
+            variables.push_back(ToVariable(literal));
+        }
+    }
+    std::sort(variables.begin(), variables.end());
+    return static_cast<Variable>(std::unique(variables.begin(), variables.end()) - variables.begin());
+}
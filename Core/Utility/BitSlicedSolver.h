@@ -0,0 +1,58 @@
+#pragma once
+
+#include "Core/DLLMakro.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "Core/Interfaces/SATSolver.h"
+
+/// <summary>
+/// Exhaustive in-process solver for problems with few used variables.
+/// Evaluates the clauses on Lanes * 64 assignments at once: every bit of a word is one assignment,
+/// the lowest variables are fixed bit patterns, the next ones select the word of a block
+/// and the remaining ones are constant within a block.
+/// The loops over the words of a block are plain, so the compiler can map them onto vector registers.
+/// Thread safe.
+/// </summary>
+class CORE_API BitSlicedSolver : public SATSolver {
+public:
+    /// <summary>
+    /// 2^MaxVariables assignments are still enumerated in a fraction of a second
+    /// </summary>
+    static const Variable MaxVariables = 24;
+    /// <summary>
+    /// words of a block (512 assignments)
+    /// </summary>
+    static const size_t Lanes = 8;
+
+    using Block = std::array<uint64_t, Lanes>;
+
+public:
+    /// <summary>
+    /// The problem must not use more than MaxVariables variables.
+    /// </summary>
+    /// <param name="problem"></param>
+    /// <param name="timeLimit"></param>
+    /// <returns></returns>
+    virtual Solution Solve(const Problem& problem, OptionalTimeLimitMs timeLimit) override;
+
+    /// <summary>
+    /// Visits every model once and keeps the first one of each projection,
+    /// stops as soon as all assignments of the projection variables are found.
+    /// The problem must not use more than MaxVariables variables.
+    /// </summary>
+    /// <param name="problem"></param>
+    /// <param name="variables">projection variables</param>
+    /// <param name="timeLimit"></param>
+    /// <returns></returns>
+    virtual Projections EnumerateProjections(const Problem& problem, const std::vector<Variable>& variables, OptionalTimeLimitMs timeLimit) override;
+
+    /// <summary>
+    /// number of variables that occur in the clauses
+    /// </summary>
+    /// <param name="problem"></param>
+    /// <returns></returns>
+    static Variable GetNumberOfUsedVariables(const Problem& problem);
+};
@@ -6,6 +6,7 @@
 #include <iostream>
 
 #include "CNFConstants.h"
+#include "Trace.h"
 #include "Core/Types/Problem.h"
 
 static void SkipSpace(const std::string& input, size_t &pos)
@@ -52,6 +53,7 @@ Clause ParseClause(const std::string& input, size_t& pos)
 
 Problem ParseCNF(std::istream& input)
 {
+    TraceSpan span("ParseCNF", "io");
     if (!input) {
         return Problem();
     }
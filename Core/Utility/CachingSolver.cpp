@@ -0,0 +1,112 @@
+#include "Core/stdafx.h"
+#include "CachingSolver.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "CompactedProblem.h"
+#include "StatsCollector.h"
+#include "Trace.h"
+
+CachingSolver::CachingSolver(std::shared_ptr<SATSolver> solver, const std::string& solverName, std::shared_ptr<SolutionStore> store) :
+    solver(solver), solverName(solverName), store(store), trustedSolvers({solverName})
+{
+    if (!solver || !store) {
+        throw std::invalid_argument("caching solver needs a solver and a store");
+    }
+}
+
+Solution CachingSolver::Solve(const Problem& problem, OptionalTimeLimitMs timeLimit)
+{
+    TraceSpan lookup("Cache lookup", "cache");
+    CompactedProblem compacted(problem);
+    auto key = GetKey(Canonicalize(compacted.GetProblem()));
+
+    for (const auto& entry : store->Find(key)) {
+        if (entry.result == SolvingResult::Unsatisfiable && trustedSolvers.find(entry.solver) != trustedSolvers.end()) {
+            hits++;
+            StatsCollector::AddCacheHits(1);
+            return {SolvingResult::Unsatisfiable, {}};
+        }
+        if (entry.result == SolvingResult::Satisfiable && entry.model->GetNumberOfVariables() == compacted.GetProblem().GetNumberOfVariables()) {
+            // a hash collision must not produce a wrong model
+            auto model = compacted.Expand(entry.model.value());
+            if (problem.Apply(model) == SolvingResult::Satisfiable) {
+                hits++;
+                StatsCollector::AddCacheHits(1);
+                return {SolvingResult::Satisfiable, std::move(model)};
+            }
+        }
+    }
+    misses++;
+    lookup.End();
+
+    auto solution = solver->Solve(problem, timeLimit);
+    if (solution.first == SolvingResult::Unsatisfiable) {
+        store->Insert(key, {SolvingResult::Unsatisfiable, solverName, {}});
+    }
+    if (solution.first == SolvingResult::Satisfiable && solution.second && problem.Apply(solution.second.value()) == SolvingResult::Satisfiable) {
+        // the model of the canonical problem
+        auto numberOfVariables = compacted.GetProblem().GetNumberOfVariables();
+        Assignment model(numberOfVariables);
+        for (Variable variable = FirstVariable; variable <= numberOfVariables; variable++) {
+            model.SetState(variable, solution.second->GetState(compacted.GetOriginalVariable(variable)));
+        }
+        store->Insert(key, {SolvingResult::Satisfiable, solverName, std::move(model)});
+    }
+    return solution;
+}
+
+void CachingSolver::SetTrustedSolvers(const std::set<std::string>& solvers)
+{
+    trustedSolvers = solvers;
+}
+
+size_t CachingSolver::GetHits() const
+{
+    return hits;
+}
+
+size_t CachingSolver::GetMisses() const
+{
+    return misses;
+}
+
+Problem CachingSolver::Canonicalize(const Problem& problem)
+{
+    auto clauses = problem.GetClauses();
+    for (auto& clause : clauses) {
+        std::sort(clause.begin(), clause.end());
+        clause.erase(std::unique(clause.begin(), clause.end()), clause.end());
+    }
+    std::sort(clauses.begin(), clauses.end());
+    clauses.erase(std::unique(clauses.begin(), clauses.end()), clauses.end());
+    return {problem.GetNumberOfVariables(), std::move(clauses)};
+}
+
+SolutionStore::Key CachingSolver::GetKey(const Problem& canonical)
+{
+    // FNV-1a and a multiply-xorshift hash over the same sequence, clauses end with 0
+    uint64_t fnv = 14695981039346656037ull;
+    uint64_t mix = 0x9E3779B97F4A7C15ull;
+    auto add = [&fnv, &mix](int64_t value) {
+        auto word = static_cast<uint64_t>(value);
+        for (int byte = 0; byte < 8; byte++) {
+            fnv ^= (word >> (8 * byte)) & 0xFF;
+            fnv *= 1099511628211ull;
+        }
+        mix ^= word + 0x9E3779B97F4A7C15ull + (mix << 6) + (mix >> 2);
+        mix ^= mix >> 31;
+        mix *= 0xBF58476D1CE4E5B9ull;
+    };
+
+    add(canonical.GetNumberOfVariables());
+    add(static_cast<int64_t>(canonical.GetClauses().size()));
+    for (const auto& clause : canonical.GetClauses()) {
+        for (auto literal : clause) {
+            add(literal);
+        }
+        add(0);
+    }
+    return {fnv, mix};
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "Core/DLLMakro.h"
+
+#include <atomic>
+#include <memory>
+#include <set>
+#include <string>
+
+#include "Core/Interfaces/SATSolver.h"
+#include "SolutionStore.h"
+
+/// <summary>
+/// Decorator that looks up the results of a solver in a persistent store before solving.
+/// The key is a hash of the canonical form of the problem: used variables renumbered in ascending order
+/// (see CompactedProblem), literals and clauses sorted, duplicates removed.
+/// A stored model is only used if Apply confirms it, unsatisfiable is only trusted from the trusted solvers.
+/// Thread safe if the solver is thread safe.
+/// </summary>
+class CORE_API CachingSolver : public SATSolver {
+private:
+    std::shared_ptr<SATSolver> solver;
+    std::string solverName;
+    std::shared_ptr<SolutionStore> store;
+    std::set<std::string> trustedSolvers;
+    std::atomic<size_t> hits{0};
+    std::atomic<size_t> misses{0};
+
+public:
+    /// <summary>
+    /// Only unsatisfiable results of solverName are trusted.
+    /// </summary>
+    /// <param name="solver"></param>
+    /// <param name="solverName">stored with every result</param>
+    /// <param name="store">may be shared by several caching solvers</param>
+    CachingSolver(std::shared_ptr<SATSolver> solver, const std::string& solverName, std::shared_ptr<SolutionStore> store);
+
+public:
+    virtual Solution Solve(const Problem& problem, OptionalTimeLimitMs timeLimit) override;
+
+    /// <summary>
+    /// solvers whose unsatisfiable results are used
+    /// </summary>
+    /// <param name="solvers"></param>
+    void SetTrustedSolvers(const std::set<std::string>& solvers);
+
+    size_t GetHits() const;
+    size_t GetMisses() const;
+
+    /// <summary>
+    /// canonical form with literals and clauses sorted, duplicates removed
+    /// </summary>
+    /// <param name="problem">without unused variables (see CompactedProblem)</param>
+    /// <returns></returns>
+    static Problem Canonicalize(const Problem& problem);
+    /// <summary>
+    /// two independent 64 bit hashes of the canonical form
+    /// </summary>
+    /// <param name="canonical"></param>
+    /// <returns></returns>
+    static SolutionStore::Key GetKey(const Problem& canonical);
+};
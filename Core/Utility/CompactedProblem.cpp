@@ -0,0 +1,107 @@
+#include "Core/stdafx.h"
+#include "CompactedProblem.h"
+
+#include <algorithm>
+
+namespace {
+
+/// <summary>
+/// sorted, without duplicates
+/// </summary>
+std::vector<Variable> FindUsedVariables(const std::vector<Clause>& clauses)
+{
+    std::vector<Variable> variables;
+    for (const auto& clause : clauses) {
+        for (auto literal : clause) {
+            variables.push_back(ToVariable(literal));
+        }
+    }
+    std::sort(variables.begin(), variables.end());
+    variables.erase(std::unique(variables.begin(), variables.end()), variables.end());
+    return variables;
+}
+
+}
+
+CompactedProblem::CompactedProblem(const Problem& problem) :
+    originalNumberOfVariables(problem.GetNumberOfVariables())
+{
+    auto used = FindUsedVariables(problem.GetClauses());
+    if (used.size() == static_cast<size_t>(problem.GetNumberOfVariables())) {
+        // nothing to renumber
+        original = &problem;
+        return;
+    }
+
+    auto clauses = problem.GetClauses();
+    Compact(clauses, used);
+}
+
+CompactedProblem::CompactedProblem(Variable numberOfVariables, std::vector<Clause>&& clauses) :
+    originalNumberOfVariables(numberOfVariables)
+{
+    auto used = FindUsedVariables(clauses);
+    if (used.size() == static_cast<size_t>(numberOfVariables)) {
+        // nothing to renumber
+        compacted = Problem(numberOfVariables, std::move(clauses));
+        return;
+    }
+    Compact(clauses, used);
+}
+
+const Problem& CompactedProblem::GetProblem() const
+{
+    return original ? *original : compacted;
+}
+
+Variable CompactedProblem::GetOriginalNumberOfVariables() const
+{
+    return originalNumberOfVariables;
+}
+
+Variable CompactedProblem::GetOriginalVariable(Variable variable) const
+{
+    return originalVariables.empty() ? variable : originalVariables[variable];
+}
+
+Assignment CompactedProblem::Expand(const Assignment& assignment) const
+{
+    if (originalVariables.empty()) {
+        return assignment;
+    }
+    Assignment ret(originalNumberOfVariables, VariableState::False);
+    ExpandInto(assignment, ret);
+    return ret;
+}
+
+Solution CompactedProblem::Expand(const Solution& solution) const
+{
+    if (!solution.second) {
+        return solution;
+    }
+    return {solution.first, Expand(solution.second.value())};
+}
+
+void CompactedProblem::ExpandInto(const Assignment& assignment, Assignment& target) const
+{
+    auto numberOfVariables = GetProblem().GetNumberOfVariables();
+    for (auto variable = FirstVariable; variable <= numberOfVariables; variable++) {
+        target.SetState(GetOriginalVariable(variable), assignment.GetState(variable));
+    }
+}
+
+void CompactedProblem::Compact(std::vector<Clause>& clauses, const std::vector<Variable>& used)
+{
+    originalVariables.reserve(used.size() + 1);
+    originalVariables.push_back(0);
+    originalVariables.insert(originalVariables.end(), used.begin(), used.end());
+
+    for (auto& clause : clauses) {
+        for (auto& literal : clause) {
+            // position in the sorted list is the new number
+            auto variable = static_cast<Variable>(std::lower_bound(used.begin(), used.end(), ToVariable(literal)) - used.begin()) + FirstVariable;
+            literal = IsPositive(literal) ? variable : Negate(variable);
+        }
+    }
+    compacted = Problem(static_cast<Variable>(used.size()), std::move(clauses));
+}
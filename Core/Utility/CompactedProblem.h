@@ -0,0 +1,75 @@
+#pragma once
+
+#include "Core/DLLMakro.h"
+
+#include <vector>
+
+#include "Core/Types/Assignment.h"
+#include "Core/Types/Problem.h"
+#include "Core/Types/Solution.h"
+
+/// <summary>
+/// Problem with the used variables renumbered to 1..k (in ascending order).
+/// Solvers only have to allocate and report the variables that actually occur.
+/// </summary>
+class CORE_API CompactedProblem {
+private:
+    /// <summary>
+    /// set if the original problem is already dense
+    /// </summary>
+    const Problem* original = nullptr;
+    Problem compacted;
+    Variable originalNumberOfVariables = 0;
+    /// <summary>
+    /// original variable of each compacted variable (index 0 unused), empty if nothing is renumbered
+    /// </summary>
+    std::vector<Variable> originalVariables;
+
+public:
+    /// <summary>
+    /// Does not copy the problem if all variables are used,
+    /// in this case the problem must outlive this object.
+    /// </summary>
+    /// <param name="problem"></param>
+    explicit CompactedProblem(const Problem& problem);
+    /// <summary>
+    /// renumbers the clauses in place
+    /// </summary>
+    /// <param name="numberOfVariables">of the original problem</param>
+    /// <param name="clauses"></param>
+    CompactedProblem(Variable numberOfVariables, std::vector<Clause>&& clauses);
+
+public:
+    const Problem& GetProblem() const;
+    Variable GetOriginalNumberOfVariables() const;
+
+    /// <summary>
+    /// Unchecked.
+    /// </summary>
+    /// <param name="variable">variable of the compacted problem</param>
+    /// <returns></returns>
+    Variable GetOriginalVariable(Variable variable) const;
+
+    /// <summary>
+    /// Assignment of the original problem, unused variables are False.
+    /// </summary>
+    /// <param name="assignment">assignment of the compacted problem</param>
+    /// <returns></returns>
+    Assignment Expand(const Assignment& assignment) const;
+    Solution Expand(const Solution& solution) const;
+
+    /// <summary>
+    /// Only writes the used variables into the assignment of the original problem.
+    /// </summary>
+    /// <param name="assignment">assignment of the compacted problem</param>
+    /// <param name="target">assignment of the original problem</param>
+    void ExpandInto(const Assignment& assignment, Assignment& target) const;
+
+private:
+    /// <summary>
+    ///
+    /// </summary>
+    /// <param name="clauses"></param>
+    /// <param name="used">sorted variables of the clauses</param>
+    void Compact(std::vector<Clause>& clauses, const std::vector<Variable>& used);
+};
@@ -0,0 +1,110 @@
+#include "Core/stdafx.h"
+#include "ConnectedComponents.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "Trace.h"
+#include "UnionFind.h"
+
+namespace {
+
+/// <summary>
+/// Below this number of literals the threads cost more than they save.
+/// </summary>
+constexpr size_t MinLiteralsPerThread = 1 << 16;
+
+template <class Sets>
+void UnionClauses(Sets& sets, const std::vector<Clause>& clauses, size_t begin, size_t end)
+{
+    for (size_t i = begin; i < end; i++) {
+        const auto& clause = clauses[i];
+        for (size_t j = 1; j < clause.size(); j++) {
+            sets.Union(ToVariable(clause[0]), ToVariable(clause[j]));
+        }
+    }
+}
+
+/// <summary>
+/// One pass over the clauses, the clause ids are collected on the way.
+/// </summary>
+template <class Sets>
+std::vector<Component> CollectComponents(Sets& sets, const Problem& problem)
+{
+    constexpr auto None = std::numeric_limits<size_t>::max();
+    const auto& clauses = problem.GetClauses();
+
+    std::vector<Component> components;
+    std::vector<size_t> componentOfRoot(sets.GetNumberOfElements(), None);
+    std::vector<bool> used(sets.GetNumberOfElements(), false);
+
+    for (size_t i = 0; i < clauses.size(); i++) {
+        const auto& clause = clauses[i];
+        if (clause.empty()) {
+            // connected to nothing
+            components.emplace_back();
+            components.back().clauses.push_back(i);
+            continue;
+        }
+
+        auto root = sets.Find(ToVariable(clause[0]));
+        if (componentOfRoot[root] == None) {
+            componentOfRoot[root] = components.size();
+            components.emplace_back();
+        }
+        components[componentOfRoot[root]].clauses.push_back(i);
+
+        for (const auto& literal : clause) {
+            used[ToVariable(literal)] = true;
+        }
+    }
+
+    // ascending by construction
+    for (auto variable = FirstVariable; variable <= problem.GetNumberOfVariables(); variable++) {
+        if (used[variable]) {
+            components[componentOfRoot[sets.Find(variable)]].variables.push_back(variable);
+        }
+    }
+
+    return components;
+}
+
+}
+
+std::vector<Component> FindConnectedComponents(const Problem& problem)
+{
+    UnionFind sets(static_cast<size_t>(problem.GetNumberOfVariables()) + 1);
+    UnionClauses(sets, problem.GetClauses(), 0, problem.GetClauses().size());
+    return CollectComponents(sets, problem);
+}
+
+std::vector<Component> FindConnectedComponentsParallel(const Problem& problem, size_t numberOfThreads)
+{
+    TraceSpan span("FindConnectedComponents", "partitioning");
+    const auto& clauses = problem.GetClauses();
+
+    size_t numberOfLiterals = 0;
+    for (const auto& clause : clauses) {
+        numberOfLiterals += clause.size();
+    }
+    numberOfThreads = std::max<size_t>(1, std::min(numberOfThreads, numberOfLiterals / MinLiteralsPerThread));
+    if (numberOfThreads == 1) {
+        return FindConnectedComponents(problem);
+    }
+
+    ConcurrentUnionFind sets(static_cast<size_t>(problem.GetNumberOfVariables()) + 1);
+    {
+        std::vector<std::thread> threads;
+        auto chunk = (clauses.size() + numberOfThreads - 1) / numberOfThreads;
+        for (size_t begin = 0; begin < clauses.size(); begin += chunk) {
+            auto end = std::min(clauses.size(), begin + chunk);
+            threads.emplace_back([&sets, &clauses, begin, end]() {
+                UnionClauses(sets, clauses, begin, end);
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+    return CollectComponents(sets, problem);
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Core/DLLMakro.h"
+
+#include <thread>
+#include <vector>
+
+#include "Core/Types/Problem.h"
+
+/// <summary>
+/// Variables that are connected by clauses, together with these clauses.
+/// </summary>
+struct Component {
+    /// <summary>
+    /// ascending
+    /// </summary>
+    std::vector<Variable> variables;
+    /// <summary>
+    /// indices into Problem::GetClauses, ascending
+    /// </summary>
+    std::vector<size_t> clauses;
+};
+
+/// <summary>
+/// Splits the problem into its connected components in near-linear time (union-find).
+/// Variables without any occurence are not part of any component.
+/// Components are ordered by their first clause.
+/// </summary>
+/// <param name="problem"></param>
+/// <returns></returns>
+CORE_API std::vector<Component> FindConnectedComponents(const Problem& problem);
+
+/// <summary>
+/// Same result as FindConnectedComponents, the clauses are merged by several threads (lock-free).
+/// </summary>
+/// <param name="problem"></param>
+/// <param name="numberOfThreads"></param>
+/// <returns></returns>
+CORE_API std::vector<Component> FindConnectedComponentsParallel(const Problem& problem, size_t numberOfThreads = std::thread::hardware_concurrency());
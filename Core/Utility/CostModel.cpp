@@ -0,0 +1,176 @@
+#include "Core/stdafx.h"
+#include "CostModel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "BenchmarkReader.h"
+#include "TaskScheduler.h"
+
+/// <summary>
+/// regularization of the normal equations, keeps them solvable if a feature is constant (e.g. only 3-SAT)
+/// </summary>
+static const double Ridge = 1e-3;
+
+static CostModel::Coefficients ToRow(double clauses, double variables, double averageClauseLength)
+{
+    return {1, std::log1p(clauses), std::log1p(variables), averageClauseLength};
+}
+
+CostModel::CostModel(size_t numberOfThreads) :
+    CostModel(Coefficients{std::log(0.001), 1, 0, 0}, numberOfThreads)
+{
+}
+
+CostModel::CostModel(const Coefficients& coefficients, size_t numberOfThreads) :
+    coefficients(coefficients), numberOfThreads(numberOfThreads)
+{
+}
+
+CostModel CostModel::Calibrate(std::istream& benchmark, const std::string& solverName, size_t numberOfThreads)
+{
+    const size_t N = std::tuple_size<Coefficients>::value;
+
+    // normal equations of the least squares fit
+    std::array<Coefficients, N> normal {};
+    Coefficients rightSide {};
+    size_t numberOfRows = 0;
+
+    BenchmarkReader reader(benchmark);
+    while (reader.Next()) {
+        auto result = reader.GetField(solverName);
+        if (!result || (result.value() != "sat" && result.value() != "unsat")) {
+            // solver was not part of this run, timed out or failed, the time is only a lower bound
+            continue;
+        }
+
+        auto features = ReadFeatures(reader);
+        auto time = reader.GetNumber(solverName + " time");
+        if (!features || !time) {
+            continue;
+        }
+
+        auto row = ToRow(static_cast<double>(features->clauses), static_cast<double>(features->variables), features->averageClauseLength);
+        auto target = std::log(std::max(time.value(), 1.0));
+        for (size_t i = 0; i < N; i++) {
+            for (size_t j = 0; j < N; j++) {
+                normal[i][j] += row[i] * row[j];
+            }
+            rightSide[i] += row[i] * target;
+        }
+        numberOfRows++;
+    }
+
+    if (numberOfRows < N) {
+        throw std::runtime_error("not enough results to calibrate the cost model");
+    }
+
+    // gaussian elimination with partial pivoting
+    for (size_t i = 0; i < N; i++) {
+        normal[i][i] += Ridge;
+    }
+    for (size_t column = 0; column < N; column++) {
+        size_t pivot = column;
+        for (size_t row = column + 1; row < N; row++) {
+            if (std::abs(normal[row][column]) > std::abs(normal[pivot][column])) {
+                pivot = row;
+            }
+        }
+        std::swap(normal[column], normal[pivot]);
+        std::swap(rightSide[column], rightSide[pivot]);
+
+        for (size_t row = column + 1; row < N; row++) {
+            auto factor = normal[row][column] / normal[column][column];
+            for (size_t j = column; j < N; j++) {
+                normal[row][j] -= factor * normal[column][j];
+            }
+            rightSide[row] -= factor * rightSide[column];
+        }
+    }
+    Coefficients coefficients {};
+    for (size_t column = N; column-- > 0;) {
+        auto sum = rightSide[column];
+        for (size_t j = column + 1; j < N; j++) {
+            sum -= normal[column][j] * coefficients[j];
+        }
+        coefficients[column] = sum / normal[column][column];
+    }
+
+    return CostModel(coefficients, numberOfThreads);
+}
+
+CostFeatures CostModel::GetFeatures(const Problem& problem)
+{
+    return GetFeatures(problem.GetClauses());
+}
+
+CostFeatures CostModel::GetFeatures(const std::vector<Clause>& clauses)
+{
+    std::vector<Variable> variables;
+    size_t numberOfLiterals = 0;
+    for (const auto& clause : clauses) {
+        numberOfLiterals += clause.size();
+        for (auto literal : clause) {
+            variables.push_back(ToVariable(literal));
+        }
+    }
+    std::sort(variables.begin(), variables.end());
+    variables.erase(std::unique(variables.begin(), variables.end()), variables.end());
+
+    CostFeatures features;
+    features.clauses = clauses.size();
+    features.variables = variables.size();
+    features.averageClauseLength = clauses.empty() ? 0 : static_cast<double>(numberOfLiterals) / clauses.size();
+    return features;
+}
+
+std::optional<CostFeatures> CostModel::ReadFeatures(const BenchmarkReader& reader)
+{
+    auto clauses = reader.GetNumber("clauses");
+    auto variables = reader.GetNumber("used variables");
+    auto length = reader.GetNumber("avg clause length");
+    if (!clauses || !variables || !length) {
+        return {};
+    }
+
+    CostFeatures features;
+    features.clauses = static_cast<size_t>(clauses.value());
+    features.variables = static_cast<size_t>(variables.value());
+    features.averageClauseLength = length.value();
+    return features;
+}
+
+const CostModel::Coefficients& CostModel::GetCoefficients() const
+{
+    return coefficients;
+}
+
+double CostModel::PredictSolveTime(const CostFeatures& features) const
+{
+    auto row = ToRow(static_cast<double>(features.clauses), static_cast<double>(features.variables), features.averageClauseLength);
+    double exponent = 0;
+    for (size_t i = 0; i < row.size(); i++) {
+        exponent += coefficients[i] * row[i];
+    }
+    return std::exp(exponent);
+}
+
+double CostModel::PredictPartitionedTime(const std::vector<PartitionCost>& partitions) const
+{
+    auto threads = numberOfThreads > 0 ? numberOfThreads : TaskScheduler::GetShared().GetNumberOfThreads();
+
+    double total = 0;
+    double slowest = 0;
+    for (const auto& partition : partitions) {
+        auto time = PredictSolveTime(partition.features);
+        total += partition.repetitions * time;
+        slowest = std::max(slowest, time);
+    }
+    return std::max(total / std::max<size_t>(threads, 1), slowest);
+}
+
+bool CostModel::IsPartitioningCheaper(const CostFeatures& problem, const std::vector<PartitionCost>& partitions) const
+{
+    return PredictPartitionedTime(partitions) < PredictSolveTime(problem);
+}
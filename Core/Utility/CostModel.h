@@ -0,0 +1,96 @@
+#pragma once
+
+#include "Core/DLLMakro.h"
+
+#include <array>
+#include <istream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Core/Types/Problem.h"
+
+class BenchmarkReader;
+
+/// <summary>
+/// Size of a (sub)problem as seen by the cost model.
+/// </summary>
+struct CostFeatures {
+    size_t clauses = 0;
+    /// <summary>
+    /// variables that occur in the clauses
+    /// </summary>
+    size_t variables = 0;
+    double averageClauseLength = 0;
+};
+
+/// <summary>
+/// Subproblem of a partitioning that is solved repetitions times (e.g. once per row of its truth table).
+/// </summary>
+struct PartitionCost {
+    CostFeatures features;
+    double repetitions = 1;
+};
+
+/// <summary>
+/// Predicts the time of the partition solver as
+/// ln(ms) = c0 + c1 * ln(1 + clauses) + c2 * ln(1 + variables) + c3 * average clause length.
+/// The coefficients are fitted by least squares on the results of a benchmark (see Benchmark),
+/// partitioned solving is predicted as the sum of its subproblems spread over the worker threads.
+/// </summary>
+class CORE_API CostModel {
+public:
+    using Coefficients = std::array<double, 4>;
+
+private:
+    Coefficients coefficients;
+    size_t numberOfThreads;
+
+public:
+    /// <summary>
+    /// uncalibrated: linear in the number of clauses
+    /// </summary>
+    /// <param name="numberOfThreads">0 uses the threads of the shared task scheduler</param>
+    explicit CostModel(size_t numberOfThreads = 0);
+    explicit CostModel(const Coefficients& coefficients, size_t numberOfThreads = 0);
+
+    /// <summary>
+    /// Fits the coefficients to a benchmark csv. Rows without a result of the solver (undef) are ignored,
+    /// repeated header lines are skipped.
+    /// </summary>
+    /// <param name="benchmark">csv written by Benchmark, see ReadFeatures</param>
+    /// <param name="solverName">name of the result column, its time column is "solverName time"</param>
+    /// <param name="numberOfThreads">see constructor</param>
+    /// <returns></returns>
+    static CostModel Calibrate(std::istream& benchmark, const std::string& solverName, size_t numberOfThreads = 0);
+
+    static CostFeatures GetFeatures(const Problem& problem);
+    static CostFeatures GetFeatures(const std::vector<Clause>& clauses);
+
+    /// <summary>
+    /// Features of the current row of a benchmark csv, the same as GetFeatures of its problem.
+    /// The declared number of variables (column "variables") is not used.
+    /// </summary>
+    /// <param name="reader"></param>
+    /// <returns>none if a column is missing, e.g. "used variables" in the results of older runs</returns>
+    static std::optional<CostFeatures> ReadFeatures(const BenchmarkReader& reader);
+
+public:
+    const Coefficients& GetCoefficients() const;
+
+    /// <summary>
+    /// predicted time in ms to solve the problem directly
+    /// </summary>
+    /// <param name="features"></param>
+    /// <returns></returns>
+    double PredictSolveTime(const CostFeatures& features) const;
+
+    /// <summary>
+    /// predicted time in ms to solve all repetitions of the partitions, at least the time of the slowest partition
+    /// </summary>
+    /// <param name="partitions"></param>
+    /// <returns></returns>
+    double PredictPartitionedTime(const std::vector<PartitionCost>& partitions) const;
+
+    bool IsPartitioningCheaper(const CostFeatures& problem, const std::vector<PartitionCost>& partitions) const;
+};
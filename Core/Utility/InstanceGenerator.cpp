@@ -0,0 +1,284 @@
+#include "Core/stdafx.h"
+#include "InstanceGenerator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <optional>
+#include <random>
+#include <stdexcept>
+
+#include "CNFConstants.h"
+
+namespace {
+
+/// <summary>
+/// Only relies on std::mt19937_64, whose output is fixed by the standard.
+/// The distributions of the standard library are implementation defined
+/// and would make the instances differ between compilers.
+/// </summary>
+class GeneratorRandom {
+private:
+    std::mt19937_64 engine;
+
+public:
+    explicit GeneratorRandom(uint64_t seed) :
+        engine(seed)
+    {
+    }
+
+    /// <summary>
+    /// uniform in [0, bound)
+    /// </summary>
+    uint64_t Next(uint64_t bound)
+    {
+        // reject the lowest values to avoid modulo bias
+        const uint64_t threshold = (0 - bound) % bound;
+        while (true) {
+            auto value = engine();
+            if (value >= threshold) {
+                return value % bound;
+            }
+        }
+    }
+
+    /// <summary>
+    /// uniform in [0, 1)
+    /// </summary>
+    double NextDouble()
+    {
+        return (engine() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    bool NextBool()
+    {
+        return (engine() >> 63) != 0;
+    }
+};
+
+/// <summary>
+/// Variables first..first+size-1 plus an optional variable shared with another component.
+/// </summary>
+struct Component {
+    Variable first;
+    Variable size;
+    std::optional<Variable> link;
+
+    Variable GetNumberOfCandidates() const
+    {
+        return size + (link ? 1 : 0);
+    }
+
+    Variable GetCandidate(uint64_t index) const
+    {
+        if (index < static_cast<uint64_t>(size)) {
+            return first + static_cast<Variable>(index);
+        }
+        return link.value();
+    }
+};
+
+void Validate(const GeneratorSettings& settings)
+{
+    if (settings.numberOfVariables <= 0) {
+        throw std::invalid_argument("generator needs at least one variable");
+    }
+    if (settings.clauseLength == 0) {
+        throw std::invalid_argument("clause length must not be 0");
+    }
+    if (settings.ratio < 0.0) {
+        throw std::invalid_argument("ratio must not be negative");
+    }
+    if (settings.numberOfComponents == 0 || settings.numberOfComponents > static_cast<size_t>(settings.numberOfVariables)) {
+        throw std::invalid_argument("number of components must be between 1 and the number of variables");
+    }
+    if (settings.modularity < 0.0 || settings.modularity > 1.0) {
+        throw std::invalid_argument("modularity must be between 0 and 1");
+    }
+}
+
+/// <summary>
+/// Splits the variables into consecutive ranges of (almost) equal size.
+/// </summary>
+std::vector<Component> CreateRanges(Variable numberOfVariables, size_t numberOfComponents)
+{
+    std::vector<Component> components;
+    auto count = static_cast<Variable>(numberOfComponents);
+    auto first = FirstVariable;
+    for (Variable i = 0; i < count; i++) {
+        auto size = numberOfVariables / count + (i < numberOfVariables % count ? 1 : 0);
+        components.push_back({first, size, {}});
+        first += size;
+    }
+    return components;
+}
+
+std::vector<Component> CreateComponents(const GeneratorSettings& settings)
+{
+    switch (settings.type) {
+        case InstanceType::RandomKSAT:
+        case InstanceType::Community:
+            return CreateRanges(settings.numberOfVariables, 1);
+        case InstanceType::DisjointUnion:
+            return CreateRanges(settings.numberOfVariables, settings.numberOfComponents);
+        case InstanceType::Chain:
+        {
+            auto components = CreateRanges(settings.numberOfVariables, settings.numberOfComponents);
+            for (size_t i = 1; i < components.size(); i++) {
+                // last variable of the predecessor
+                components[i].link = components[i - 1].first + components[i - 1].size - 1;
+            }
+            return components;
+        }
+        case InstanceType::Star:
+        {
+            auto components = CreateRanges(settings.numberOfVariables, settings.numberOfComponents);
+            const auto& center = components[0];
+            for (size_t i = 1; i < components.size(); i++) {
+                // spread the satellites over the variables of the center
+                components[i].link = center.first + static_cast<Variable>((i - 1) % center.size);
+            }
+            return components;
+        }
+    }
+    throw std::invalid_argument("unknown instance type");
+}
+
+size_t GetNumberOfClauses(const GeneratorSettings& settings, Variable numberOfVariables)
+{
+    return static_cast<size_t>(std::llround(settings.ratio * numberOfVariables));
+}
+
+bool IsSatisfied(const Clause& clause, const Assignment& assignment)
+{
+    return std::any_of(clause.begin(), clause.end(), [&assignment](auto literal) {
+        return assignment.IsSAT(literal);
+    });
+}
+
+/// <summary>
+/// Draws clauseLength distinct variables (or all candidates if there are fewer) with random signs.
+/// If forced is set, it is the variable of the first literal.
+/// </summary>
+template <class DrawVariable>
+void DrawClause(Clause& clause, size_t clauseLength, Variable numberOfCandidates, std::optional<Variable> forced, GeneratorRandom& random, DrawVariable drawVariable)
+{
+    auto length = std::min(clauseLength, static_cast<size_t>(numberOfCandidates));
+    clause.clear();
+    if (forced) {
+        clause.push_back(forced.value());
+    }
+    while (clause.size() < length) {
+        auto variable = drawVariable();
+        if (std::find(clause.begin(), clause.end(), variable) == clause.end()) {
+            clause.push_back(variable);
+        }
+    }
+    for (auto& literal : clause) {
+        if (random.NextBool()) {
+            literal = Negate(literal);
+        }
+    }
+}
+
+}
+
+size_t GetNumberOfClauses(const GeneratorSettings& settings)
+{
+    Validate(settings);
+
+    size_t sum = 0;
+    for (const auto& component : CreateComponents(settings)) {
+        sum += GetNumberOfClauses(settings, component.size);
+    }
+    return sum;
+}
+
+Assignment GetPlantedAssignment(const GeneratorSettings& settings)
+{
+    Validate(settings);
+
+    // separate stream, so the assignment does not depend on the generated clauses
+    GeneratorRandom random(settings.seed ^ 0x9E3779B97F4A7C15ull);
+    Assignment assignment(settings.numberOfVariables);
+    for (auto variable = FirstVariable; variable <= settings.numberOfVariables; variable++) {
+        assignment.SetState(variable, random.NextBool() ? VariableState::True : VariableState::False);
+    }
+    return assignment;
+}
+
+void GenerateClauses(const GeneratorSettings& settings, const std::function<void(const Clause&)>& consumer)
+{
+    Validate(settings);
+
+    GeneratorRandom random(settings.seed);
+    std::optional<Assignment> planted;
+    if (settings.planted) {
+        planted = GetPlantedAssignment(settings);
+    }
+
+    Clause clause;
+    clause.reserve(settings.clauseLength);
+
+    auto emit = [&](Variable numberOfCandidates, std::optional<Variable> forced, auto drawVariable) {
+        do {
+            DrawClause(clause, settings.clauseLength, numberOfCandidates, forced, random, drawVariable);
+        } while (planted && !IsSatisfied(clause, planted.value()));
+        consumer(clause);
+    };
+
+    if (settings.type == InstanceType::Community) {
+        auto communities = CreateRanges(settings.numberOfVariables, settings.numberOfComponents);
+        auto numberOfClauses = GetNumberOfClauses(settings, settings.numberOfVariables);
+        for (size_t i = 0; i < numberOfClauses; i++) {
+            if (random.NextDouble() < settings.modularity) {
+                const auto& community = communities[random.Next(communities.size())];
+                emit(community.size, {}, [&]() {
+                    return community.GetCandidate(random.Next(community.size));
+                });
+            } else {
+                emit(settings.numberOfVariables, {}, [&]() {
+                    return static_cast<Variable>(FirstVariable + random.Next(settings.numberOfVariables));
+                });
+            }
+        }
+        return;
+    }
+
+    for (const auto& component : CreateComponents(settings)) {
+        auto numberOfClauses = GetNumberOfClauses(settings, component.size);
+        auto numberOfCandidates = component.GetNumberOfCandidates();
+        for (size_t i = 0; i < numberOfClauses; i++) {
+            // the first clause of a linked component always contains the shared variable,
+            // otherwise the link could vanish for small ratios
+            std::optional<Variable> forced;
+            if (i == 0) {
+                forced = component.link;
+            }
+            emit(numberOfCandidates, forced, [&]() {
+                return component.GetCandidate(random.Next(numberOfCandidates));
+            });
+        }
+    }
+}
+
+Problem GenerateProblem(const GeneratorSettings& settings)
+{
+    std::vector<Clause> clauses;
+    clauses.reserve(GetNumberOfClauses(settings));
+    GenerateClauses(settings, [&clauses](const Clause& clause) {
+        clauses.push_back(clause);
+    });
+    return Problem(settings.numberOfVariables, std::move(clauses));
+}
+
+void WriteGeneratedCNF(const GeneratorSettings& settings, std::ostream& output)
+{
+    // write header
+    output << CNFHeader << " " << settings.numberOfVariables << " " << GetNumberOfClauses(settings) << '\n';
+
+    // no flush per clause, the instances may be huge
+    GenerateClauses(settings, [&output](const Clause& clause) {
+        output << clause << '\n';
+    });
+    output.flush();
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "Core/DLLMakro.h"
+
+#include <cstdint>
+#include <functional>
+#include <ostream>
+
+#include "Core/Types/Assignment.h"
+#include "Core/Types/Problem.h"
+
+enum class InstanceType : char {
+    /// <summary>
+    /// uniform random k-SAT over all variables
+    /// </summary>
+    RandomKSAT,
+    /// <summary>
+    /// independent random k-SAT components over disjoint variable ranges
+    /// </summary>
+    DisjointUnion,
+    /// <summary>
+    /// components where each one shares exactly one variable with its predecessor
+    /// </summary>
+    Chain,
+    /// <summary>
+    /// satellite components that share exactly one variable with the first (center) component
+    /// </summary>
+    Star,
+    /// <summary>
+    /// clauses mostly stay within one community of variables
+    /// </summary>
+    Community,
+};
+
+struct GeneratorSettings {
+    InstanceType type = InstanceType::RandomKSAT;
+    Variable numberOfVariables = 100;
+    size_t clauseLength = 3;
+    /// <summary>
+    /// clauses per variable
+    /// </summary>
+    double ratio = 4.26;
+    uint64_t seed = 0;
+    /// <summary>
+    /// number of components (DisjointUnion, Chain, Star) or communities (Community)
+    /// </summary>
+    size_t numberOfComponents = 1;
+    /// <summary>
+    /// probability that a clause of a Community instance stays within one community
+    /// </summary>
+    double modularity = 0.8;
+    /// <summary>
+    /// only emit clauses satisfied by GetPlantedAssignment
+    /// </summary>
+    bool planted = false;
+};
+
+/// <summary>
+/// Number of clauses the generator emits for the given settings.
+/// Known before generation, so the header can be written first when streaming.
+/// </summary>
+/// <param name="settings"></param>
+/// <returns></returns>
+CORE_API size_t GetNumberOfClauses(const GeneratorSettings& settings);
+
+/// <summary>
+/// Hidden solution of planted instances. Depends on the seed only.
+/// </summary>
+/// <param name="settings"></param>
+/// <returns></returns>
+CORE_API Assignment GetPlantedAssignment(const GeneratorSettings& settings);
+
+/// <summary>
+/// Generates the clauses one by one without keeping them in memory.
+/// The same settings always produce the same clauses, independent of the platform.
+/// </summary>
+/// <param name="settings"></param>
+/// <param name="consumer">called once per clause</param>
+CORE_API void GenerateClauses(const GeneratorSettings& settings, const std::function<void(const Clause&)>& consumer);
+
+CORE_API Problem GenerateProblem(const GeneratorSettings& settings);
+
+/// <summary>
+/// Streams the generated instance to the output in dimacs/cnf.
+/// </summary>
+/// <param name="settings"></param>
+/// <param name="output"></param>
+CORE_API void WriteGeneratedCNF(const GeneratorSettings& settings, std::ostream& output);
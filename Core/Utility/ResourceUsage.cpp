@@ -0,0 +1,47 @@
+#include "Core/stdafx.h"
+#include "ResourceUsage.h"
+
+#include <cstdint>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#ifdef _WIN32
+ResourceUsage GetResourceUsage()
+{
+    ResourceUsage usage;
+    FILETIME creation, exit, kernel, user;
+    if (GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user)) {
+        // 100 ns units
+        auto ticks = (static_cast<uint64_t>(kernel.dwHighDateTime) << 32 | kernel.dwLowDateTime)
+            + (static_cast<uint64_t>(user.dwHighDateTime) << 32 | user.dwLowDateTime);
+        usage.cpuTime = std::chrono::milliseconds(ticks / 10000);
+    }
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        usage.peakMemory = counters.PeakWorkingSetSize;
+    }
+    return usage;
+}
+#else
+ResourceUsage GetResourceUsage()
+{
+    ResourceUsage usage;
+    rusage self;
+    if (getrusage(RUSAGE_SELF, &self) == 0) {
+        auto toMilliseconds = [](const timeval& time) {
+            return std::chrono::milliseconds(static_cast<int64_t>(time.tv_sec) * 1000 + time.tv_usec / 1000);
+        };
+        usage.cpuTime = toMilliseconds(self.ru_utime) + toMilliseconds(self.ru_stime);
+        // kilobytes
+        usage.peakMemory = static_cast<size_t>(self.ru_maxrss) * 1024;
+    }
+    return usage;
+}
+#endif
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "Core/DLLMakro.h"
+
+#include <chrono>
+#include <cstddef>
+
+struct ResourceUsage {
+    /// <summary>
+    /// user and kernel time of all threads
+    /// </summary>
+    std::chrono::milliseconds cpuTime {0};
+    /// <summary>
+    /// peak resident memory in bytes
+    /// </summary>
+    size_t peakMemory = 0;
+};
+
+/// <summary>
+/// resources used by the process so far
+/// </summary>
+/// <returns></returns>
+CORE_API ResourceUsage GetResourceUsage();
@@ -0,0 +1,144 @@
+#include "Core/stdafx.h"
+#include "RestrictionEngine.h"
+
+#include <algorithm>
+
+RestrictionEngine::RestrictionEngine(const std::vector<Clause>& clauses)
+{
+    for (const auto& clause : clauses) {
+        for (auto literal : clause) {
+            variables.push_back(ToVariable(literal));
+        }
+    }
+    std::sort(variables.begin(), variables.end());
+    variables.erase(std::unique(variables.begin(), variables.end()), variables.end());
+
+    clauseOffsets.reserve(clauses.size() + 1);
+    clauseOffsets.push_back(0);
+    std::vector<size_t> occurrenceCounts(2 * variables.size() + 1, 0);
+    for (const auto& clause : clauses) {
+        auto first = literals.size();
+        for (auto literal : clause) {
+            auto local = static_cast<size_t>(std::lower_bound(variables.begin(), variables.end(), ToVariable(literal)) - variables.begin());
+            literals.push_back(2 * local + (IsPositive(literal) ? 0 : 1));
+        }
+        std::sort(literals.begin() + first, literals.end());
+        literals.erase(std::unique(literals.begin() + first, literals.end()), literals.end());
+        for (auto i = first; i < literals.size(); i++) {
+            occurrenceCounts[literals[i] + 1]++;
+        }
+        hasEmptyClause |= first == literals.size();
+        clauseOffsets.push_back(literals.size());
+    }
+
+    // counting sort of the clauses by literal
+    for (size_t i = 1; i < occurrenceCounts.size(); i++) {
+        occurrenceCounts[i] += occurrenceCounts[i - 1];
+    }
+    occurrenceOffsets = occurrenceCounts;
+    occurrences.resize(literals.size());
+    for (size_t clause = 0; clause + 1 < clauseOffsets.size(); clause++) {
+        for (auto i = clauseOffsets[clause]; i < clauseOffsets[clause + 1]; i++) {
+            occurrences[occurrenceCounts[literals[i]]++] = clause;
+        }
+    }
+}
+
+size_t RestrictionEngine::GetNumberOfClauses() const
+{
+    return clauseOffsets.size() - 1;
+}
+
+RestrictionResult RestrictionEngine::Restrict(const Assignment& assignment) const
+{
+    RestrictionResult result;
+    if (hasEmptyClause) {
+        result.conflict = true;
+        return result;
+    }
+
+    // true literals whose clauses have not been visited yet
+    std::vector<size_t> trail;
+    std::vector<VariableState> states(variables.size());
+    for (size_t local = 0; local < variables.size(); local++) {
+        states[local] = assignment.GetState(variables[local]);
+        if (states[local] != VariableState::Undefined) {
+            trail.push_back(2 * local + (states[local] == VariableState::True ? 0 : 1));
+        }
+    }
+    auto isFalse = [&states](size_t literal) {
+        auto state = states[literal / 2];
+        return state != VariableState::Undefined && (state == VariableState::True) == (literal % 2 == 1);
+    };
+    auto imply = [&](size_t literal) {
+        states[literal / 2] = literal % 2 == 0 ? VariableState::True : VariableState::False;
+        trail.push_back(literal);
+        result.implied.push_back(ToLiteral(literal));
+    };
+
+    // number of literals of each clause that are not falsified
+    std::vector<size_t> remaining(GetNumberOfClauses());
+    for (size_t clause = 0; clause < remaining.size(); clause++) {
+        remaining[clause] = clauseOffsets[clause + 1] - clauseOffsets[clause];
+        if (remaining[clause] == 1 && states[literals[clauseOffsets[clause]] / 2] == VariableState::Undefined) {
+            imply(literals[clauseOffsets[clause]]);
+        }
+    }
+
+    std::vector<bool> satisfied(GetNumberOfClauses(), false);
+    for (size_t head = 0; head < trail.size(); head++) {
+        auto literal = trail[head];
+        for (auto i = occurrenceOffsets[literal]; i < occurrenceOffsets[literal + 1]; i++) {
+            satisfied[occurrences[i]] = true;
+        }
+        auto negated = literal ^ 1;
+        for (auto i = occurrenceOffsets[negated]; i < occurrenceOffsets[negated + 1]; i++) {
+            auto clause = occurrences[i];
+            if (satisfied[clause]) {
+                continue;
+            }
+            if (--remaining[clause] == 0) {
+                result.conflict = true;
+                return result;
+            }
+            if (remaining[clause] == 1) {
+                // the last literal that is not falsified must be true,
+                // implied literals are falsified before their clauses are visited
+                auto first = literals.begin() + clauseOffsets[clause];
+                auto last = literals.begin() + clauseOffsets[clause + 1];
+                auto unit = std::find_if(first, last, [&isFalse](auto other) {
+                    return !isFalse(other);
+                });
+                if (unit == last) {
+                    result.conflict = true;
+                    return result;
+                }
+                if (states[*unit / 2] == VariableState::Undefined) {
+                    imply(*unit);
+                }
+            }
+        }
+    }
+
+    // at the fixpoint every clause that is not satisfied has at least two unassigned literals
+    for (size_t clause = 0; clause < remaining.size(); clause++) {
+        if (satisfied[clause]) {
+            continue;
+        }
+        Clause restricted;
+        restricted.reserve(remaining[clause]);
+        for (auto i = clauseOffsets[clause]; i < clauseOffsets[clause + 1]; i++) {
+            if (states[literals[i] / 2] == VariableState::Undefined) {
+                restricted.push_back(ToLiteral(literals[i]));
+            }
+        }
+        result.clauses.push_back(std::move(restricted));
+    }
+    return result;
+}
+
+Literal RestrictionEngine::ToLiteral(size_t localLiteral) const
+{
+    auto variable = variables[localLiteral / 2];
+    return localLiteral % 2 == 0 ? variable : Negate(variable);
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "Core/DLLMakro.h"
+
+#include <vector>
+
+#include "Core/Types/Assignment.h"
+#include "Core/Types/Clause.h"
+
+/// <summary>
+/// Clauses restricted by a partial assignment and closed under unit propagation.
+/// </summary>
+struct RestrictionResult {
+    /// <summary>
+    /// a clause is falsified, the other members are incomplete
+    /// </summary>
+    bool conflict = false;
+    /// <summary>
+    /// literals that are implied by unit propagation (not part of the assignment)
+    /// </summary>
+    std::vector<Literal> implied;
+    /// <summary>
+    /// clauses that are neither satisfied nor units, without falsified literals
+    /// </summary>
+    std::vector<Clause> clauses;
+};
+
+/// <summary>
+/// Applies partial assignments to a fixed set of clauses.
+/// The clauses and an occurrence list of each literal are built once,
+/// so a restriction only visits the clauses of the assigned literals and copies the remaining ones.
+/// Restrict may be called concurrently.
+/// </summary>
+class CORE_API RestrictionEngine {
+private:
+    /// <summary>
+    /// variables of the clauses, sorted; local variable i is variables[i]
+    /// </summary>
+    std::vector<Variable> variables;
+    /// <summary>
+    /// local literals of clause i are literals[clauseOffsets[i]] .. literals[clauseOffsets[i + 1] - 1], without duplicates;
+    /// the local literal of local variable v is 2 * v if it is positive and 2 * v + 1 if it is negated
+    /// </summary>
+    std::vector<size_t> clauseOffsets;
+    std::vector<size_t> literals;
+    /// <summary>
+    /// clauses of local literal l are occurrences[occurrenceOffsets[l]] .. occurrences[occurrenceOffsets[l + 1] - 1]
+    /// </summary>
+    std::vector<size_t> occurrenceOffsets;
+    std::vector<size_t> occurrences;
+    bool hasEmptyClause = false;
+
+public:
+    explicit RestrictionEngine(const std::vector<Clause>& clauses);
+
+public:
+    size_t GetNumberOfClauses() const;
+
+    /// <summary>
+    /// Removes satisfied clauses and falsified literals and propagates the resulting units to a fixpoint.
+    /// Stops at the first falsified clause.
+    /// </summary>
+    /// <param name="assignment">variables that do not occur in the clauses are ignored</param>
+    /// <returns></returns>
+    RestrictionResult Restrict(const Assignment& assignment) const;
+
+private:
+    Literal ToLiteral(size_t localLiteral) const;
+};
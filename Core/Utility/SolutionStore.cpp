@@ -0,0 +1,334 @@
+#include "Core/stdafx.h"
+#include "SolutionStore.h"
+
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+
+/// <summary>
+/// record: magic, length of the payload, payload, checksum of the payload
+/// payload: key, result, length of the solver name, solver name, number of variables, model (one bit per variable)
+/// </summary>
+static const uint32_t Magic = 0x52435357;
+static const char* SegmentExtension = ".segment";
+
+static uint64_t Checksum(const std::string& bytes)
+{
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ull;
+    for (auto byte : bytes) {
+        hash ^= static_cast<unsigned char>(byte);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+template <class T>
+static void Write(std::string& bytes, T value)
+{
+    bytes.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <class T>
+static bool Read(const std::string& bytes, size_t& position, T& value)
+{
+    if (position + sizeof(value) > bytes.size()) {
+        return false;
+    }
+    std::memcpy(&value, bytes.data() + position, sizeof(value));
+    position += sizeof(value);
+    return true;
+}
+
+static std::string Serialize(const SolutionStore::Key& key, const SolutionStore::Entry& entry)
+{
+    std::string payload;
+    Write(payload, key[0]);
+    Write(payload, key[1]);
+    Write(payload, static_cast<uint8_t>(entry.result));
+    Write(payload, static_cast<uint16_t>(entry.solver.size()));
+    payload += entry.solver;
+    auto numberOfVariables = entry.model ? static_cast<uint32_t>(entry.model->GetNumberOfVariables()) : 0;
+    Write(payload, numberOfVariables);
+    std::string bits((numberOfVariables + 7) / 8, '\0');
+    for (uint32_t i = 0; i < numberOfVariables; i++) {
+        if (entry.model->GetState(static_cast<Variable>(i) + FirstVariable) == VariableState::True) {
+            bits[i / 8] |= static_cast<char>(1 << (i % 8));
+        }
+    }
+    payload += bits;
+
+    std::string record;
+    Write(record, Magic);
+    Write(record, static_cast<uint32_t>(payload.size()));
+    record += payload;
+    Write(record, Checksum(payload));
+    return record;
+}
+
+static bool Deserialize(const std::string& payload, SolutionStore::Key& key, SolutionStore::Entry& entry)
+{
+    size_t position = 0;
+    uint8_t result = 0;
+    uint16_t solverLength = 0;
+    if (!Read(payload, position, key[0]) || !Read(payload, position, key[1]) || !Read(payload, position, result) || !Read(payload, position, solverLength)) {
+        return false;
+    }
+    if (position + solverLength > payload.size()) {
+        return false;
+    }
+    entry.result = static_cast<SolvingResult>(result);
+    entry.solver = payload.substr(position, solverLength);
+    position += solverLength;
+
+    uint32_t numberOfVariables = 0;
+    if (!Read(payload, position, numberOfVariables) || position + (numberOfVariables + 7) / 8 != payload.size()) {
+        return false;
+    }
+    if (entry.result == SolvingResult::Satisfiable) {
+        Assignment model(static_cast<Variable>(numberOfVariables));
+        for (uint32_t i = 0; i < numberOfVariables; i++) {
+            auto bit = (payload[position + i / 8] >> (i % 8)) & 1;
+            model.SetState(static_cast<Variable>(i) + FirstVariable, bit ? VariableState::True : VariableState::False);
+        }
+        entry.model = std::move(model);
+    }
+    return entry.result == SolvingResult::Satisfiable || entry.result == SolvingResult::Unsatisfiable;
+}
+
+size_t SolutionStore::KeyHash::operator()(const Key& key) const
+{
+    // the key is a hash already
+    return static_cast<size_t>(key[0] ^ key[1]);
+}
+
+static std::string CreateSegmentName()
+{
+    // unique per process and store
+    std::random_device device;
+    std::stringstream name;
+    name << std::hex << std::chrono::system_clock::now().time_since_epoch().count() << "-" << device() << device() << SegmentExtension;
+    return name.str();
+}
+
+SolutionStore::SolutionStore(const std::filesystem::path& directory, std::chrono::milliseconds rescanInterval) :
+    directory(directory),
+    rescanInterval(rescanInterval)
+{
+    std::filesystem::create_directories(directory);
+
+    // the segment is created with the first insert
+    ownSegment = directory / CreateSegmentName();
+
+    ReadSegments();
+    Compact();
+}
+
+std::vector<SolutionStore::Entry> SolutionStore::Find(const Key& key)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = entries.find(key);
+        if (it != entries.end()) {
+            return it->second;
+        }
+        if (std::chrono::steady_clock::now() - lastScan < rescanInterval) {
+            // most lookups of a partitioner miss, they must not all read the directory
+            return {};
+        }
+    }
+
+    // another process may have solved it in the meantime
+    ReadSegments();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = entries.find(key);
+    if (it == entries.end()) {
+        return {};
+    }
+    return it->second;
+}
+
+void SolutionStore::Insert(const Key& key, const Entry& entry)
+{
+    if (entry.result != SolvingResult::Satisfiable && entry.result != SolvingResult::Unsatisfiable) {
+        throw std::invalid_argument("only definite results can be stored");
+    }
+    if (entry.result == SolvingResult::Satisfiable && !entry.model) {
+        throw std::invalid_argument("satisfiable entry without model");
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!Add(entries, key, entry)) {
+        return;
+    }
+    if (!output.is_open()) {
+        output.open(ownSegment, std::ios::binary | std::ios::app);
+        if (!output) {
+            throw std::runtime_error("could not create segment of the solution store");
+        }
+    }
+    // one write per record, readers skip incomplete records
+    auto record = Serialize(key, entry);
+    output.write(record.data(), record.size());
+    output.flush();
+}
+
+void SolutionStore::ReadSegments()
+{
+    std::map<std::filesystem::path, uint64_t> offsets;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (scanning) {
+            return;
+        }
+        scanning = true;
+        offsets = readOffsets;
+    }
+
+    Records records;
+    try {
+        std::error_code error;
+        for (const auto& file : std::filesystem::directory_iterator(directory, error)) {
+            const auto& path = file.path();
+            if (path == ownSegment || path.extension() != SegmentExtension) {
+                continue;
+            }
+            auto& offset = offsets[path];
+            offset += ReadSegment(path, offset, records);
+        }
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex);
+        scanning = false;
+        throw;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto& [key, entry] : records) {
+        Add(entries, key, std::move(entry));
+    }
+    // only the scanning thread changes the offsets
+    readOffsets = std::move(offsets);
+    lastScan = std::chrono::steady_clock::now();
+    scanning = false;
+}
+
+void SolutionStore::Compact()
+{
+    auto now = std::filesystem::file_time_type::clock::now();
+    std::vector<std::filesystem::path> inactive;
+    std::error_code error;
+    for (const auto& file : std::filesystem::directory_iterator(directory, error)) {
+        const auto& path = file.path();
+        if (path == ownSegment || path.extension() != SegmentExtension) {
+            continue;
+        }
+        auto time = std::filesystem::last_write_time(path, error);
+        if (!error && now - time >= CompactionAge) {
+            inactive.push_back(path);
+        }
+    }
+    if (inactive.size() < 2) {
+        return;
+    }
+
+    // the segments are read again, the entries of the store do not remember their segment
+    Entries merged;
+    std::string bytes;
+    for (const auto& path : inactive) {
+        Records records;
+        ReadSegment(path, 0, records);
+        for (auto& [key, entry] : records) {
+            auto record = Serialize(key, entry);
+            if (Add(merged, key, std::move(entry))) {
+                bytes += record;
+            }
+        }
+    }
+
+    // readers never see a partial segment
+    auto segment = directory / CreateSegmentName();
+    auto temporary = segment;
+    temporary.replace_extension(".tmp");
+    {
+        std::ofstream output(temporary, std::ios::binary);
+        output.write(bytes.data(), bytes.size());
+        if (!output) {
+            output.close();
+            std::filesystem::remove(temporary, error);
+            return;
+        }
+    }
+    std::filesystem::rename(temporary, segment, error);
+    if (error) {
+        std::filesystem::remove(temporary, error);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    readOffsets[segment] = bytes.size();
+    for (const auto& path : inactive) {
+        if (std::filesystem::remove(path, error)) {
+            readOffsets.erase(path);
+        }
+    }
+}
+
+uint64_t SolutionStore::ReadSegment(const std::filesystem::path& path, uint64_t offset, Records& records)
+{
+    std::ifstream input(path, std::ios::binary);
+    if (!input) {
+        return 0;
+    }
+    input.seekg(0, std::ios::end);
+    auto size = static_cast<uint64_t>(input.tellg());
+    if (size <= offset) {
+        return 0;
+    }
+    std::string bytes(static_cast<size_t>(size - offset), '\0');
+    input.seekg(static_cast<std::streamoff>(offset));
+    input.read(&bytes[0], bytes.size());
+    bytes.resize(static_cast<size_t>(input.gcount()));
+
+    size_t position = 0;
+    while (true) {
+        size_t next = position;
+        uint32_t magic = 0;
+        uint32_t length = 0;
+        uint64_t checksum = 0;
+        if (!Read(bytes, next, magic) || !Read(bytes, next, length) || next + length + sizeof(checksum) > bytes.size()) {
+            // incomplete, read again later
+            break;
+        }
+        if (magic != Magic) {
+            // not a segment of this store
+            position = bytes.size();
+            break;
+        }
+        auto payload = bytes.substr(next, length);
+        next += length;
+        Read(bytes, next, checksum);
+        position = next;
+
+        Key key;
+        Entry entry;
+        if (checksum == Checksum(payload) && Deserialize(payload, key, entry)) {
+            records.emplace_back(key, std::move(entry));
+        }
+    }
+    return position;
+}
+
+bool SolutionStore::Add(Entries& entries, const Key& key, Entry entry)
+{
+    auto& known = entries[key];
+    for (const auto& other : known) {
+        if (other.result == entry.result && (entry.result == SolvingResult::Satisfiable || other.solver == entry.solver)) {
+            return false;
+        }
+    }
+    known.push_back(std::move(entry));
+    return true;
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+#include "Core/DLLMakro.h"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Core/Types/Assignment.h"
+#include "Core/Types/SolvingResult.h"
+
+/// <summary>
+/// Persistent key-value store of solving results, shared by threads and processes.
+/// The store is a directory of append-only segment files, every process writes its own segment
+/// and reads the segments of the others, so no file is written concurrently.
+/// Records are framed and checksummed, a record that is still being written is read later.
+/// Segments that were not written for CompactionAge are merged into one when a store is opened.
+/// Thread safe.
+/// </summary>
+class CORE_API SolutionStore {
+public:
+    /// <summary>
+    /// content hash of a problem (see CachingSolver)
+    /// </summary>
+    using Key = std::array<uint64_t, 2>;
+
+    /// <summary>
+    /// misses read the segments of the other processes at most once per interval
+    /// </summary>
+    static constexpr std::chrono::milliseconds DefaultRescanInterval {1000};
+    /// <summary>
+    /// a segment that was not written for this time belongs to a finished process
+    /// </summary>
+    static constexpr std::chrono::minutes CompactionAge {10};
+
+    struct Entry {
+        SolvingResult result = SolvingResult::Undefined;
+        /// <summary>
+        /// solver that found the result
+        /// </summary>
+        std::string solver;
+        /// <summary>
+        /// set if satisfiable
+        /// </summary>
+        std::optional<Assignment> model;
+    };
+
+private:
+    struct KeyHash {
+        size_t operator()(const Key& key) const;
+    };
+
+    using Entries = std::unordered_map<Key, std::vector<Entry>, KeyHash>;
+    using Records = std::vector<std::pair<Key, Entry>>;
+
+private:
+    std::filesystem::path directory;
+    std::filesystem::path ownSegment;
+    std::ofstream output;
+    std::chrono::milliseconds rescanInterval;
+    std::mutex mutex;
+    Entries entries;
+    /// <summary>
+    /// bytes read of each segment of the other processes
+    /// </summary>
+    std::map<std::filesystem::path, uint64_t> readOffsets;
+    std::chrono::steady_clock::time_point lastScan;
+    /// <summary>
+    /// a thread reads the segments, the others do not wait for it
+    /// </summary>
+    bool scanning = false;
+
+public:
+    /// <summary>
+    /// Creates the directory if necessary, reads the existing segments and merges the old ones.
+    /// </summary>
+    /// <param name="directory"></param>
+    /// <param name="rescanInterval"></param>
+    explicit SolutionStore(const std::filesystem::path& directory, std::chrono::milliseconds rescanInterval = DefaultRescanInterval);
+
+public:
+    /// <summary>
+    /// Reads the records that other processes appended since the last read if the key is unknown,
+    /// at most once per rescan interval.
+    /// </summary>
+    /// <param name="key"></param>
+    /// <returns>all entries of the key: at most one satisfiable entry and one unsatisfiable entry per solver</returns>
+    std::vector<Entry> Find(const Key& key);
+    /// <summary>
+    /// Appends the entry to the segment of this process, only definite results may be inserted.
+    /// </summary>
+    /// <param name="key"></param>
+    /// <param name="entry"></param>
+    void Insert(const Key& key, const Entry& entry);
+
+private:
+    /// <summary>
+    /// Reads the new records of the other segments, the files are read without holding the mutex.
+    /// </summary>
+    void ReadSegments();
+    /// <summary>
+    /// Merges the segments that were not written for CompactionAge into a new segment.
+    /// A segment that cannot be removed (e.g. still open) is kept, its entries are deduplicated when read.
+    /// Where open files can be removed, records appended later by an idle process are only lost for the others.
+    /// </summary>
+    void Compact();
+    /// <summary>
+    /// Reads the complete records of a segment from the offset.
+    /// </summary>
+    /// <param name="path"></param>
+    /// <param name="offset"></param>
+    /// <param name="records"></param>
+    /// <returns>number of bytes read</returns>
+    static uint64_t ReadSegment(const std::filesystem::path& path, uint64_t offset, Records& records);
+    /// <summary>
+    /// the mutex must be held for the entries of the store
+    /// </summary>
+    /// <param name="entries"></param>
+    /// <param name="key"></param>
+    /// <param name="entry"></param>
+    /// <returns>false if the entry is known already</returns>
+    static bool Add(Entries& entries, const Key& key, Entry entry);
+};
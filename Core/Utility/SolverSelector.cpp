@@ -0,0 +1,295 @@
+#include "Core/stdafx.h"
+#include "SolverSelector.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+
+#include "BenchmarkReader.h"
+
+/// <summary>
+/// an earlier step gets this multiple of the longest time it needed for a neighbour
+/// </summary>
+static const double Slack = 2;
+static const double MaxStepShare = 0.5;
+static const std::chrono::milliseconds MinStepTime(1000);
+
+static const char Separator = ';';
+static const char* NotSolved = "-";
+/// <summary>
+/// models of older versions used the declared number of variables
+/// </summary>
+static const char* Features = "features;clauses;used variables;avg clause length";
+
+SolverSelector SolverSelector::Train(std::istream& benchmark, const std::vector<std::string>& solvers, size_t numberOfNeighbours)
+{
+    std::vector<Sample> samples;
+    std::map<std::string, size_t> sampleOfProblem;
+
+    BenchmarkReader reader(benchmark);
+    while (reader.Next()) {
+        auto problem = reader.GetField("problem");
+        auto features = CostModel::ReadFeatures(reader);
+        if (!problem || !features || reader.GetField("valid") == std::string("0")) {
+            continue;
+        }
+
+        auto [it, inserted] = sampleOfProblem.emplace(problem.value(), samples.size());
+        if (inserted) {
+            Sample sample;
+            sample.features = features.value();
+            sample.times.resize(solvers.size());
+            samples.push_back(std::move(sample));
+        }
+        auto& sample = samples[it->second];
+        for (size_t solver = 0; solver < solvers.size(); solver++) {
+            auto result = reader.GetField(solvers[solver]);
+            if (!result) {
+                // not part of this run
+                continue;
+            }
+            auto time = reader.GetNumber(solvers[solver] + " time");
+            if ((result.value() == "sat" || result.value() == "unsat") && time) {
+                sample.times[solver] = time.value();
+            } else {
+                sample.times[solver].reset();
+            }
+        }
+    }
+
+    auto solved = std::any_of(samples.begin(), samples.end(), [](const auto& sample) {
+        return std::any_of(sample.times.begin(), sample.times.end(), [](const auto& time) {
+            return time.has_value();
+        });
+    });
+    if (!solved) {
+        throw std::runtime_error("not enough results to train the solver selector");
+    }
+    return SolverSelector(solvers, std::move(samples), numberOfNeighbours);
+}
+
+SolverSelector SolverSelector::Load(std::istream& model)
+{
+    auto readLine = [&model]() {
+        std::string line;
+        if (!std::getline(model, line)) {
+            throw std::runtime_error("invalid solver selector model");
+        }
+        std::vector<std::string> fields;
+        std::stringstream stream(line);
+        std::string field;
+        while (std::getline(stream, field, Separator)) {
+            fields.push_back(field);
+        }
+        return fields;
+    };
+    auto toNumber = [](const std::string& field) {
+        try {
+            return std::stod(field);
+        } catch (std::logic_error&) {
+            throw std::runtime_error("invalid solver selector model");
+        }
+    };
+
+    // k;<neighbours>
+    auto fields = readLine();
+    if (fields.size() != 2 || fields[0] != "k") {
+        throw std::runtime_error("invalid solver selector model");
+    }
+    auto numberOfNeighbours = static_cast<size_t>(toNumber(fields[1]));
+
+    // solvers;<name>;...
+    fields = readLine();
+    if (fields.size() < 2 || fields[0] != "solvers") {
+        throw std::runtime_error("invalid solver selector model");
+    }
+    std::vector<std::string> solvers(fields.begin() + 1, fields.end());
+
+    std::string line;
+    if (!std::getline(model, line) || line != Features) {
+        throw std::runtime_error("invalid solver selector model");
+    }
+
+    // <clauses>;<variables>;<avg clause length>;<ms or - per solver>
+    std::vector<Sample> samples;
+    while (std::getline(model, line)) {
+        if (line.empty()) {
+            continue;
+        }
+        std::stringstream stream(line);
+        fields.clear();
+        std::string field;
+        while (std::getline(stream, field, Separator)) {
+            fields.push_back(field);
+        }
+        if (fields.size() != 3 + solvers.size()) {
+            throw std::runtime_error("invalid solver selector model");
+        }
+        Sample sample;
+        sample.features.clauses = static_cast<size_t>(toNumber(fields[0]));
+        sample.features.variables = static_cast<size_t>(toNumber(fields[1]));
+        sample.features.averageClauseLength = toNumber(fields[2]);
+        for (size_t solver = 0; solver < solvers.size(); solver++) {
+            const auto& time = fields[3 + solver];
+            sample.times.push_back(time == NotSolved ? std::optional<double>() : toNumber(time));
+        }
+        samples.push_back(std::move(sample));
+    }
+    if (samples.empty()) {
+        throw std::runtime_error("invalid solver selector model");
+    }
+    return SolverSelector(std::move(solvers), std::move(samples), numberOfNeighbours);
+}
+
+SolverSelector::SolverSelector(std::vector<std::string> solvers, std::vector<Sample> samples, size_t numberOfNeighbours) :
+    solvers(std::move(solvers)), samples(std::move(samples)), numberOfNeighbours(std::max<size_t>(numberOfNeighbours, 1))
+{
+    // standardize, otherwise the clause length would not matter next to the sizes
+    mean.fill(0);
+    deviation.fill(0);
+    for (const auto& sample : this->samples) {
+        points.push_back(ToPoint(sample.features));
+    }
+    for (const auto& point : points) {
+        for (size_t i = 0; i < point.size(); i++) {
+            mean[i] += point[i] / points.size();
+        }
+    }
+    for (const auto& point : points) {
+        for (size_t i = 0; i < point.size(); i++) {
+            deviation[i] += (point[i] - mean[i]) * (point[i] - mean[i]) / points.size();
+        }
+    }
+    for (auto& value : deviation) {
+        value = value > 0 ? std::sqrt(value) : 1;
+    }
+    for (auto& point : points) {
+        for (size_t i = 0; i < point.size(); i++) {
+            point[i] = (point[i] - mean[i]) / deviation[i];
+        }
+    }
+}
+
+void SolverSelector::Save(std::ostream& model) const
+{
+    model << "k" << Separator << numberOfNeighbours << std::endl;
+    model << "solvers";
+    for (const auto& solver : solvers) {
+        model << Separator << solver;
+    }
+    model << std::endl;
+    model << Features << std::endl;
+    for (const auto& sample : samples) {
+        model << sample.features.clauses << Separator << sample.features.variables << Separator << sample.features.averageClauseLength;
+        for (const auto& time : sample.times) {
+            model << Separator;
+            if (time) {
+                model << time.value();
+            } else {
+                model << NotSolved;
+            }
+        }
+        model << std::endl;
+    }
+}
+
+const std::vector<std::string>& SolverSelector::GetSolvers() const
+{
+    return solvers;
+}
+
+size_t SolverSelector::GetNumberOfSamples() const
+{
+    return samples.size();
+}
+
+std::vector<ScheduleStep> SolverSelector::Select(const CostFeatures& features, OptionalTimeLimitMs timeLimit) const
+{
+    auto point = ToPoint(features);
+    for (size_t i = 0; i < point.size(); i++) {
+        point[i] = (point[i] - mean[i]) / deviation[i];
+    }
+
+    // nearest samples
+    std::vector<std::pair<double, size_t>> distances;
+    distances.reserve(points.size());
+    for (size_t sample = 0; sample < points.size(); sample++) {
+        double distance = 0;
+        for (size_t i = 0; i < point.size(); i++) {
+            distance += (points[sample][i] - point[i]) * (points[sample][i] - point[i]);
+        }
+        distances.emplace_back(distance, sample);
+    }
+    auto k = std::min(numberOfNeighbours, distances.size());
+    std::partial_sort(distances.begin(), distances.begin() + k, distances.end());
+
+    // number of solved neighbours, median and longest time per solver
+    struct Statistics {
+        size_t solved = 0;
+        double median = 0;
+        double longest = 0;
+    };
+    std::vector<Statistics> statistics(solvers.size());
+    for (size_t solver = 0; solver < solvers.size(); solver++) {
+        std::vector<double> times;
+        for (size_t neighbour = 0; neighbour < k; neighbour++) {
+            const auto& time = samples[distances[neighbour].second].times[solver];
+            if (time) {
+                times.push_back(time.value());
+            }
+        }
+        if (times.empty()) {
+            continue;
+        }
+        std::sort(times.begin(), times.end());
+        statistics[solver].solved = times.size();
+        statistics[solver].median = times[times.size() / 2];
+        statistics[solver].longest = times.back();
+    }
+
+    std::vector<size_t> order(solvers.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&statistics](auto l, auto r) {
+        if (statistics[l].solved != statistics[r].solved) {
+            return statistics[l].solved > statistics[r].solved;
+        }
+        return statistics[l].median < statistics[r].median;
+    });
+    auto main = order.front();
+
+    // faster solvers first, each with a bounded share of the time
+    std::vector<size_t> earlier;
+    for (auto solver : order) {
+        if (solver != main && statistics[solver].solved > 0 && statistics[solver].median < statistics[main].median) {
+            earlier.push_back(solver);
+        }
+    }
+    std::sort(earlier.begin(), earlier.end(), [&statistics](auto l, auto r) {
+        return statistics[l].median < statistics[r].median;
+    });
+
+    std::vector<ScheduleStep> schedule;
+    auto remaining = timeLimit;
+    for (auto solver : earlier) {
+        auto stepTime = std::max(MinStepTime, std::chrono::milliseconds(static_cast<int64_t>(std::ceil(Slack * statistics[solver].longest))));
+        if (remaining) {
+            stepTime = std::min(stepTime, std::chrono::duration_cast<std::chrono::milliseconds>(remaining.value() * MaxStepShare));
+            if (stepTime < MinStepTime) {
+                // not enough time to switch solvers
+                break;
+            }
+            remaining = remaining.value() - stepTime;
+        }
+        schedule.push_back({solvers[solver], stepTime});
+    }
+    schedule.push_back({solvers[main], {}});
+    return schedule;
+}
+
+SolverSelector::Point SolverSelector::ToPoint(const CostFeatures& features)
+{
+    return {std::log1p(static_cast<double>(features.clauses)), std::log1p(static_cast<double>(features.variables)), features.averageClauseLength};
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "Core/DLLMakro.h"
+
+#include <array>
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "CostModel.h"
+#include "TimeLimit.h"
+
+/// <summary>
+/// One solver of a schedule, the solvers are run in order until one decides the problem.
+/// </summary>
+struct ScheduleStep {
+    std::string solver;
+    /// <summary>
+    /// none for the remaining time
+    /// </summary>
+    OptionalTimeLimitMs timeLimit;
+};
+
+/// <summary>
+/// Chooses the order and time split of a solver portfolio per instance
+/// by the k nearest instances of earlier benchmarks (k-NN on the features of CostModel).
+/// The solver that solved most neighbours gets the remaining time, solvers that solved
+/// their neighbours faster run before it with enough time to solve these neighbours again.
+/// The model is the list of benchmark results, it is stored as a plain text file (see Save).
+/// </summary>
+class CORE_API SolverSelector {
+public:
+    static const size_t DefaultNeighbours = 5;
+
+private:
+    using Point = std::array<double, 3>;
+
+    struct Sample {
+        CostFeatures features;
+        /// <summary>
+        /// ms per solver, none if not solved
+        /// </summary>
+        std::vector<std::optional<double>> times;
+    };
+
+private:
+    std::vector<std::string> solvers;
+    std::vector<Sample> samples;
+    size_t numberOfNeighbours;
+    /// <summary>
+    /// standardized features of the samples
+    /// </summary>
+    std::vector<Point> points;
+    Point mean;
+    Point deviation;
+
+public:
+    /// <summary>
+    /// Collects the results of the solvers per problem, later runs overwrite earlier results.
+    /// Rows with contradicting results (not valid) or without features (see CostModel::ReadFeatures) are ignored.
+    /// </summary>
+    /// <param name="benchmark">csv written by Benchmark</param>
+    /// <param name="solvers">names of the result columns, the first one is used if no neighbour was solved</param>
+    /// <param name="numberOfNeighbours"></param>
+    /// <returns></returns>
+    static SolverSelector Train(std::istream& benchmark, const std::vector<std::string>& solvers, size_t numberOfNeighbours = DefaultNeighbours);
+
+    /// <summary>
+    /// Reads a model written by Save, models of older versions (declared number of variables) are rejected.
+    /// </summary>
+    /// <param name="model"></param>
+    /// <returns></returns>
+    static SolverSelector Load(std::istream& model);
+
+private:
+    SolverSelector(std::vector<std::string> solvers, std::vector<Sample> samples, size_t numberOfNeighbours);
+
+public:
+    void Save(std::ostream& model) const;
+
+    const std::vector<std::string>& GetSolvers() const;
+    size_t GetNumberOfSamples() const;
+
+    /// <summary>
+    /// Schedule for an instance, the last step always gets the remaining time.
+    /// </summary>
+    /// <param name="features"></param>
+    /// <param name="timeLimit">of the whole schedule, the earlier steps get at most half of what is left</param>
+    /// <returns></returns>
+    std::vector<ScheduleStep> Select(const CostFeatures& features, OptionalTimeLimitMs timeLimit) const;
+
+private:
+    static Point ToPoint(const CostFeatures& features);
+};
@@ -0,0 +1,77 @@
+#include "Core/stdafx.h"
+#include "StatsCollector.h"
+
+static thread_local std::shared_ptr<StatsCollector> current;
+
+StatsCollector::Scope::Scope(std::shared_ptr<StatsCollector> collector) :
+    previous(std::move(current))
+{
+    current = std::move(collector);
+}
+
+StatsCollector::Scope::~Scope()
+{
+    current = std::move(previous);
+}
+
+void StatsCollector::Add(const SolveStats& counters)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    stats += counters;
+}
+
+SolveStats StatsCollector::Get()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+std::shared_ptr<StatsCollector> StatsCollector::GetCurrent()
+{
+    return current;
+}
+
+void StatsCollector::AddSubproblems(size_t count)
+{
+    if (current) {
+        SolveStats counters;
+        counters.subproblems = count;
+        current->Add(counters);
+    }
+}
+
+void StatsCollector::AddCutSize(size_t size)
+{
+    if (current) {
+        SolveStats counters;
+        counters.cutSize = size;
+        current->Add(counters);
+    }
+}
+
+void StatsCollector::AddProcessTime(std::chrono::milliseconds time)
+{
+    if (current) {
+        SolveStats counters;
+        counters.processTime = time;
+        current->Add(counters);
+    }
+}
+
+void StatsCollector::AddCacheHits(size_t count)
+{
+    if (current) {
+        SolveStats counters;
+        counters.cacheHits = count;
+        current->Add(counters);
+    }
+}
+
+void StatsCollector::AddConflicts(size_t count)
+{
+    if (current) {
+        SolveStats counters;
+        counters.conflicts = count;
+        current->Add(counters);
+    }
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Core/DLLMakro.h"
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+
+#include "Core/Types/SolveStats.h"
+
+/// <summary>
+/// Thread safe sum of the counters of one solve.
+/// The collector of the running solve is bound to the calling thread and passed on to the tasks of a TaskGroup,
+/// so solvers report their counters without knowing who is measuring.
+/// Reporting without a bound collector does nothing.
+/// </summary>
+class CORE_API StatsCollector {
+private:
+    std::mutex mutex;
+    SolveStats stats;
+
+public:
+    /// <summary>
+    /// Binds a collector to the calling thread until the end of the scope.
+    /// </summary>
+    class CORE_API Scope {
+    private:
+        std::shared_ptr<StatsCollector> previous;
+
+    public:
+        /// <summary>
+        /// </summary>
+        /// <param name="collector">may be empty, nothing is collected then</param>
+        explicit Scope(std::shared_ptr<StatsCollector> collector);
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+        ~Scope();
+    };
+
+public:
+    void Add(const SolveStats& counters);
+    SolveStats Get();
+
+    /// <summary>
+    /// collector bound to the calling thread
+    /// </summary>
+    /// <returns>empty if nothing is collected</returns>
+    static std::shared_ptr<StatsCollector> GetCurrent();
+
+    static void AddSubproblems(size_t count);
+    static void AddCutSize(size_t size);
+    static void AddProcessTime(std::chrono::milliseconds time);
+    static void AddCacheHits(size_t count);
+    static void AddConflicts(size_t count);
+};
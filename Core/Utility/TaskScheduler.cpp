@@ -0,0 +1,177 @@
+#include "Core/stdafx.h"
+#include "TaskScheduler.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "StatsCollector.h"
+
+TaskScheduler::TaskScheduler(size_t numberOfThreads)
+{
+    numberOfThreads = std::max<size_t>(1, numberOfThreads);
+    for (size_t i = 0; i < numberOfThreads; i++) {
+        workers.emplace_back(&TaskScheduler::Work, this);
+    }
+}
+
+TaskScheduler::~TaskScheduler()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    condition.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+TaskScheduler& TaskScheduler::GetShared()
+{
+    // never destroyed: joining threads while the dll is unloaded can dead lock
+    static auto shared = new TaskScheduler();
+    return *shared;
+}
+
+void TaskScheduler::Submit(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push_back(std::move(task));
+    }
+    condition.notify_one();
+}
+
+bool TaskScheduler::RunPendingTask()
+{
+    std::function<void()> task;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (tasks.empty()) {
+            return false;
+        }
+        task = std::move(tasks.front());
+        tasks.pop_front();
+    }
+    task();
+    return true;
+}
+
+size_t TaskScheduler::GetNumberOfThreads() const
+{
+    return workers.size();
+}
+
+void TaskScheduler::Work()
+{
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [this]() {
+                return stopping || !tasks.empty();
+            });
+            if (tasks.empty()) {
+                // stopping
+                return;
+            }
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        task();
+    }
+}
+
+TaskGroup::TaskGroup(TaskScheduler& scheduler) :
+    scheduler(scheduler),
+    state(std::make_shared<State>())
+{
+}
+
+TaskGroup::~TaskGroup()
+{
+    try {
+        Wait();
+    } catch (...) {
+        // destructor must not throw
+    }
+}
+
+void TaskGroup::Run(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        state->pending++;
+    }
+
+    // the state is kept alive by the task itself, the task reports to the statistics of the submitting solve
+    scheduler.Submit([state = state, task = std::move(task), stats = StatsCollector::GetCurrent()]() {
+        StatsCollector::Scope scope(stats);
+        bool cancelled;
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            cancelled = state->cancelled;
+        }
+
+        if (!cancelled) {
+            try {
+                task();
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                if (!state->exception) {
+                    state->exception = std::current_exception();
+                }
+                state->cancelled = true;
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->pending--;
+        }
+        state->condition.notify_all();
+    });
+}
+
+void TaskGroup::Wait()
+{
+    while (true) {
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            if (state->pending == 0) {
+                break;
+            }
+        }
+
+        // help instead of blocking a thread of the scheduler
+        if (scheduler.RunPendingTask()) {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(state->mutex);
+        state->condition.wait_for(lock, std::chrono::milliseconds(1), [this]() {
+            return state->pending == 0;
+        });
+    }
+
+    std::exception_ptr exception;
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        std::swap(exception, state->exception);
+    }
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
+}
+
+void TaskGroup::Cancel()
+{
+    std::lock_guard<std::mutex> lock(state->mutex);
+    state->cancelled = true;
+}
+
+bool TaskGroup::IsCancelled() const
+{
+    std::lock_guard<std::mutex> lock(state->mutex);
+    return state->cancelled;
+}
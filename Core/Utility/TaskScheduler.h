@@ -0,0 +1,100 @@
+#pragma once
+
+#include "Core/DLLMakro.h"
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// <summary>
+/// Fixed pool of worker threads executing submitted tasks in FIFO order.
+/// Use TaskGroup to wait for a set of tasks.
+/// </summary>
+class CORE_API TaskScheduler {
+private:
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool stopping = false;
+
+public:
+    explicit TaskScheduler(size_t numberOfThreads = std::thread::hardware_concurrency());
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
+    virtual ~TaskScheduler();
+
+    /// <summary>
+    /// Scheduler shared by all solvers of the process.
+    /// </summary>
+    /// <returns></returns>
+    static TaskScheduler& GetShared();
+
+public:
+    void Submit(std::function<void()> task);
+
+    /// <summary>
+    /// Executes one queued task in the calling thread.
+    /// </summary>
+    /// <returns>false if there was no queued task</returns>
+    bool RunPendingTask();
+
+    size_t GetNumberOfThreads() const;
+
+private:
+    void Work();
+};
+
+/// <summary>
+/// Set of tasks that can be waited for and cancelled together.
+/// Waiting threads execute queued tasks meanwhile, so groups may be nested inside tasks.
+/// </summary>
+class CORE_API TaskGroup {
+private:
+    struct State {
+        std::mutex mutex;
+        std::condition_variable condition;
+        size_t pending = 0;
+        bool cancelled = false;
+        std::exception_ptr exception;
+    };
+
+    TaskScheduler& scheduler;
+    std::shared_ptr<State> state;
+
+public:
+    explicit TaskGroup(TaskScheduler& scheduler = TaskScheduler::GetShared());
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+    /// <summary>
+    /// waits for the tasks, exceptions are dropped
+    /// </summary>
+    virtual ~TaskGroup();
+
+public:
+    /// <summary>
+    /// The task is skipped if the group is cancelled before it starts.
+    /// An exception thrown by the task cancels the group.
+    /// </summary>
+    /// <param name="task"></param>
+    void Run(std::function<void()> task);
+
+    /// <summary>
+    /// Blocks until all tasks are finished or skipped.
+    /// Rethrows the first exception of a task.
+    /// </summary>
+    void Wait();
+
+    /// <summary>
+    /// Tasks that did not start yet will be skipped. Running tasks are not interrupted,
+    /// long running tasks should poll IsCancelled.
+    /// </summary>
+    void Cancel();
+
+    bool IsCancelled() const;
+};
@@ -0,0 +1,77 @@
+#include "Core/stdafx.h"
+#include "TimeBudget.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+TimeBudget::TimeBudget(OptionalTimeLimitMs timeLimit, std::chrono::steady_clock::time_point start, std::vector<double> weights, size_t parallelism, std::chrono::milliseconds minimumShare) :
+    timeLimit(timeLimit),
+    start(start),
+    weights(std::move(weights)),
+    started(this->weights.size(), false),
+    parallelism(std::max<size_t>(1, parallelism)),
+    minimumShare(minimumShare)
+{
+    if (std::any_of(this->weights.begin(), this->weights.end(), [](auto weight) {
+        return !(weight > 0) || !std::isfinite(weight);
+    })) {
+        throw std::invalid_argument("weight of a job must be positive and finite");
+    }
+    pendingWeight = std::accumulate(this->weights.begin(), this->weights.end(), 0.0);
+}
+
+OptionalTimeLimitMs TimeBudget::Start(size_t job)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (job >= weights.size() || started[job]) {
+        throw std::invalid_argument("job is unknown or already started");
+    }
+    started[job] = true;
+    auto weight = weights[job];
+    // the last job gets everything, rounding must not leave time behind
+    auto share = pendingWeight > weight ? weight / pendingWeight : 1.0;
+    pendingWeight -= weight;
+
+    auto remaining = ::GetRemaining(timeLimit, start);
+    if (!remaining) {
+        return remaining;
+    }
+
+    // the running jobs may still use the rest of their shares
+    auto now = std::chrono::steady_clock::now();
+    auto reserved = std::chrono::milliseconds(0);
+    for (const auto& [other, allotment] : running) {
+        auto used = std::chrono::duration_cast<std::chrono::milliseconds>(now - allotment.start);
+        reserved += std::max(allotment.share - used, std::chrono::milliseconds(0));
+    }
+    auto pool = std::max(remaining.value() * static_cast<int64_t>(parallelism) - reserved, std::chrono::milliseconds(0));
+
+    auto limit = std::chrono::duration_cast<std::chrono::milliseconds>(pool * share);
+    limit = std::max(limit, minimumShare);
+    limit = std::min(limit, remaining.value());
+    running[job] = {now, limit};
+    return limit;
+}
+
+void TimeBudget::Finish(size_t job)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    running.erase(job);
+}
+
+void TimeBudget::Skip(size_t job)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (job >= weights.size() || started[job]) {
+        throw std::invalid_argument("job is unknown or already started");
+    }
+    started[job] = true;
+    pendingWeight -= weights[job];
+}
+
+OptionalTimeLimitMs TimeBudget::GetRemaining() const
+{
+    return ::GetRemaining(timeLimit, start);
+}
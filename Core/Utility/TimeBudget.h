@@ -0,0 +1,78 @@
+#pragma once
+
+#include "Core/DLLMakro.h"
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include "TimeLimit.h"
+
+/// <summary>
+/// Splits the time until a deadline among a known set of jobs in proportion to their estimated difficulty.
+/// A job gets its share when it starts: the time left (times the number of jobs that run at once)
+/// minus what the running jobs still hold, weighted among the jobs that did not start yet.
+/// Time a finished job did not use goes back to the pool. No share exceeds the deadline.
+/// Jobs may be nested partitioners that split their share again.
+/// Thread safe.
+/// </summary>
+class CORE_API TimeBudget {
+public:
+    /// <summary>
+    /// a share is not smaller (unless the deadline is closer), shorter limits mostly produce Undefined
+    /// </summary>
+    static constexpr std::chrono::milliseconds DefaultMinimumShare {1000};
+
+private:
+    struct Allotment {
+        std::chrono::steady_clock::time_point start;
+        std::chrono::milliseconds share;
+    };
+
+    std::mutex mutex;
+    OptionalTimeLimitMs timeLimit;
+    std::chrono::steady_clock::time_point start;
+    std::vector<double> weights;
+    std::vector<bool> started;
+    double pendingWeight = 0;
+    size_t parallelism;
+    std::chrono::milliseconds minimumShare;
+    std::map<size_t, Allotment> running;
+
+public:
+    /// <summary>
+    /// </summary>
+    /// <param name="timeLimit">deadline of the parent, none: the jobs get no limit</param>
+    /// <param name="start">start of the time limit</param>
+    /// <param name="weights">estimated difficulty of every job, positive and finite</param>
+    /// <param name="parallelism">number of jobs that run at once</param>
+    /// <param name="minimumShare"></param>
+    TimeBudget(OptionalTimeLimitMs timeLimit, std::chrono::steady_clock::time_point start, std::vector<double> weights, size_t parallelism = 1, std::chrono::milliseconds minimumShare = DefaultMinimumShare);
+
+public:
+    /// <summary>
+    /// Reserves the share of a job, every job is started at most once.
+    /// </summary>
+    /// <param name="job">index of the weight</param>
+    /// <returns>time limit of the job, none if the parent has no limit</returns>
+    OptionalTimeLimitMs Start(size_t job);
+
+    /// <summary>
+    /// Returns the unused time of the job to the pool.
+    /// </summary>
+    /// <param name="job"></param>
+    void Finish(size_t job);
+
+    /// <summary>
+    /// Gives the weight of a job that will not run to the jobs that did not start yet.
+    /// </summary>
+    /// <param name="job"></param>
+    void Skip(size_t job);
+
+    /// <summary>
+    /// time until the deadline of the parent
+    /// </summary>
+    /// <returns></returns>
+    OptionalTimeLimitMs GetRemaining() const;
+};
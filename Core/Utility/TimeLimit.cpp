@@ -1,6 +1,8 @@
 #include "Core/stdafx.h"
 #include "TimeLimit.h"
 
+#include <algorithm>
+
 std::chrono::nanoseconds GetElapsed(std::chrono::steady_clock::time_point start)
 {
     return std::chrono::steady_clock::now() - start;
@@ -12,7 +14,9 @@ OptionalTimeLimitMs GetRemaining(OptionalTimeLimitMs timeLimit, std::chrono::ste
         return timeLimit;
     }
 
-    return std::chrono::duration_cast<std::chrono::milliseconds>(timeLimit.value() - GetElapsed(start));
+    // an exceeded limit stays exceeded, a negative limit would confuse the solvers
+    auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(timeLimit.value() - GetElapsed(start));
+    return std::max(remaining, std::chrono::milliseconds(0));
 
 }
 
@@ -0,0 +1,127 @@
+#include "Core/stdafx.h"
+#include "Trace.h"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+struct Event {
+    const char* name;
+    const char* category;
+    int64_t start;
+    int64_t duration;
+};
+
+/// <summary>
+/// Spans of one thread. The lock is only contended while exporting.
+/// Owned by the registry as well, so the spans survive the thread.
+/// </summary>
+struct Buffer {
+    std::mutex mutex;
+    std::vector<Event> events;
+    size_t thread;
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<Buffer>> buffers;
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+};
+}
+
+std::atomic<bool> Tracer::enabled{false};
+
+static Registry& GetRegistry()
+{
+    static Registry registry;
+    return registry;
+}
+
+static Buffer& GetBuffer()
+{
+    thread_local std::shared_ptr<Buffer> buffer;
+    if (!buffer) {
+        buffer = std::make_shared<Buffer>();
+        auto& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        buffer->thread = registry.buffers.size();
+        registry.buffers.push_back(buffer);
+    }
+    return *buffer;
+}
+
+static void WriteString(std::ostream& output, const char* text)
+{
+    output << '"';
+    for (auto c = text; *c != '\0'; c++) {
+        if (*c == '"' || *c == '\\') {
+            output << '\\';
+        }
+        output << *c;
+    }
+    output << '"';
+}
+
+void Tracer::Enable()
+{
+    // fixes the time origin before the first span
+    GetRegistry();
+    enabled = true;
+}
+
+void Tracer::Disable()
+{
+    enabled = false;
+}
+
+void Tracer::WriteChromeTrace(std::ostream& output)
+{
+    std::vector<std::shared_ptr<Buffer>> buffers;
+    {
+        auto& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        buffers = registry.buffers;
+    }
+
+    output << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    for (const auto& buffer : buffers) {
+        std::lock_guard<std::mutex> lock(buffer->mutex);
+        for (const auto& event : buffer->events) {
+            output << (first ? "\n" : ",\n");
+            first = false;
+            output << "{\"name\":";
+            WriteString(output, event.name);
+            output << ",\"cat\":";
+            WriteString(output, event.category);
+            output << ",\"ph\":\"X\",\"ts\":" << event.start << ",\"dur\":" << event.duration;
+            output << ",\"pid\":1,\"tid\":" << buffer->thread << "}";
+        }
+    }
+    output << "\n]}" << std::endl;
+}
+
+void Tracer::Clear()
+{
+    auto& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (const auto& buffer : registry.buffers) {
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        buffer->events.clear();
+    }
+}
+
+int64_t Tracer::Now()
+{
+    auto elapsed = std::chrono::steady_clock::now() - GetRegistry().start;
+    return std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+}
+
+void Tracer::Record(const char* name, const char* category, int64_t start)
+{
+    auto end = Now();
+    auto& buffer = GetBuffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    buffer.events.push_back({name, category, start, end - start});
+}
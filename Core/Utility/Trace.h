@@ -0,0 +1,91 @@
+#pragma once
+
+#include "Core/DLLMakro.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+
+/// <summary>
+/// Process wide collection of trace spans, exported in the Chrome trace format
+/// (load the file in chrome://tracing or https://ui.perfetto.dev).
+/// Every thread records into its own buffer, the buffers are only merged on export.
+/// Off by default, a disabled span only reads one atomic flag.
+/// </summary>
+class CORE_API Tracer {
+private:
+    static std::atomic<bool> enabled;
+
+public:
+    static void Enable();
+    static void Disable();
+    static bool IsEnabled()
+    {
+        return enabled.load(std::memory_order_relaxed);
+    }
+
+    /// <summary>
+    /// Writes the spans of all threads recorded so far as a Chrome trace (JSON object format).
+    /// </summary>
+    /// <param name="output"></param>
+    static void WriteChromeTrace(std::ostream& output);
+    /// <summary>
+    /// Removes the recorded spans.
+    /// </summary>
+    static void Clear();
+
+    /// <summary>
+    /// microseconds since the start of the process trace
+    /// </summary>
+    /// <returns></returns>
+    static int64_t Now();
+    /// <summary>
+    /// Appends a finished span to the buffer of the calling thread.
+    /// </summary>
+    /// <param name="name">must outlive the tracer (string literal)</param>
+    /// <param name="category">must outlive the tracer (string literal)</param>
+    /// <param name="start">see Now</param>
+    static void Record(const char* name, const char* category, int64_t start);
+};
+
+/// <summary>
+/// RAII span: records the time from construction to destruction (or End) if tracing was enabled at construction.
+/// Usage: TraceSpan span("FindCutSet", "partitioning");
+/// </summary>
+class CORE_API TraceSpan {
+private:
+    const char* name;
+    const char* category;
+    int64_t start = -1;
+
+public:
+    /// <summary>
+    /// </summary>
+    /// <param name="name">must outlive the tracer (string literal)</param>
+    /// <param name="category">must outlive the tracer (string literal)</param>
+    TraceSpan(const char* name, const char* category) :
+        name(name), category(category)
+    {
+        if (Tracer::IsEnabled()) {
+            start = Tracer::Now();
+        }
+    }
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+    ~TraceSpan()
+    {
+        End();
+    }
+
+    /// <summary>
+    /// Ends the span before the end of the scope.
+    /// </summary>
+    void End()
+    {
+        if (start >= 0) {
+            Tracer::Record(name, category, start);
+            start = -1;
+        }
+    }
+};
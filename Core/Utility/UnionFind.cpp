@@ -0,0 +1,94 @@
+#include "Core/stdafx.h"
+#include "UnionFind.h"
+
+#include <numeric>
+#include <utility>
+
+UnionFind::UnionFind(size_t numberOfElements) :
+    parent(numberOfElements),
+    size(numberOfElements, 1)
+{
+    std::iota(parent.begin(), parent.end(), 0);
+}
+
+size_t UnionFind::Find(size_t element)
+{
+    while (parent[element] != element) {
+        // path halving
+        parent[element] = parent[parent[element]];
+        element = parent[element];
+    }
+    return element;
+}
+
+bool UnionFind::Union(size_t l, size_t r)
+{
+    l = Find(l);
+    r = Find(r);
+    if (l == r) {
+        return false;
+    }
+
+    // attach smaller tree
+    if (size[l] < size[r]) {
+        std::swap(l, r);
+    }
+    parent[r] = l;
+    size[l] += size[r];
+    return true;
+}
+
+size_t UnionFind::GetNumberOfElements() const
+{
+    return parent.size();
+}
+
+ConcurrentUnionFind::ConcurrentUnionFind(size_t numberOfElements) :
+    parent(numberOfElements)
+{
+    for (size_t i = 0; i < numberOfElements; i++) {
+        parent[i].store(i, std::memory_order_relaxed);
+    }
+}
+
+size_t ConcurrentUnionFind::Find(size_t element)
+{
+    while (true) {
+        auto p = parent[element].load(std::memory_order_acquire);
+        if (p == element) {
+            return element;
+        }
+        auto grandParent = parent[p].load(std::memory_order_acquire);
+        if (p != grandParent) {
+            // path halving, losing the race only means less compression
+            parent[element].compare_exchange_weak(p, grandParent, std::memory_order_release, std::memory_order_relaxed);
+        }
+        element = grandParent;
+    }
+}
+
+bool ConcurrentUnionFind::Union(size_t l, size_t r)
+{
+    while (true) {
+        l = Find(l);
+        r = Find(r);
+        if (l == r) {
+            return false;
+        }
+
+        // parents always have a smaller index than their children, hence no cycles
+        if (l < r) {
+            std::swap(l, r);
+        }
+        auto expected = l;
+        if (parent[l].compare_exchange_strong(expected, r, std::memory_order_acq_rel)) {
+            return true;
+        }
+        // l was linked by another thread in the meantime -> retry with the new roots
+    }
+}
+
+size_t ConcurrentUnionFind::GetNumberOfElements() const
+{
+    return parent.size();
+}
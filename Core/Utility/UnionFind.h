@@ -0,0 +1,67 @@
+#pragma once
+
+#include "Core/DLLMakro.h"
+
+#include <atomic>
+#include <vector>
+
+/// <summary>
+/// Disjoint sets over the elements 0..numberOfElements-1.
+/// Union by size, path halving.
+/// </summary>
+class CORE_API UnionFind {
+private:
+    std::vector<size_t> parent;
+    std::vector<size_t> size;
+
+public:
+    explicit UnionFind(size_t numberOfElements);
+
+public:
+    /// <summary>
+    /// Unchecked.
+    /// </summary>
+    /// <param name="element"></param>
+    /// <returns>representative of the set of element</returns>
+    size_t Find(size_t element);
+
+    /// <summary>
+    /// Unchecked.
+    /// </summary>
+    /// <param name="l"></param>
+    /// <param name="r"></param>
+    /// <returns>false if both were in the same set already</returns>
+    bool Union(size_t l, size_t r);
+
+    size_t GetNumberOfElements() const;
+};
+
+/// <summary>
+/// Lock-free variant of UnionFind, Find and Union may be called from several threads at once.
+/// Roots are always linked below the smaller index, so the representatives are deterministic.
+/// </summary>
+class CORE_API ConcurrentUnionFind {
+private:
+    std::vector<std::atomic<size_t>> parent;
+
+public:
+    explicit ConcurrentUnionFind(size_t numberOfElements);
+
+public:
+    /// <summary>
+    /// Unchecked.
+    /// </summary>
+    /// <param name="element"></param>
+    /// <returns>representative of the set of element</returns>
+    size_t Find(size_t element);
+
+    /// <summary>
+    /// Unchecked.
+    /// </summary>
+    /// <param name="l"></param>
+    /// <param name="r"></param>
+    /// <returns>false if both were in the same set already</returns>
+    bool Union(size_t l, size_t r);
+
+    size_t GetNumberOfElements() const;
+};
@@ -0,0 +1,133 @@
+#include "CoreTest/stdafx.h"
+#include "CppUnitTest.h"
+
+#include <algorithm>
+
+#include "Core/Utility/InstanceGenerator.h"
+#include "Partitioning/Utility/ClauseRouter.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace CoreTest {
+TEST_CLASS(ClauseRouterTest)
+{
+public:
+
+    TEST_METHOD(TestClauseRouter_Sequential)
+    {
+        // large enough for several tasks, the links between the components are the cut set
+        const Variable numberOfVariables = 40000;
+        const Variable componentSize = 10000;
+        GeneratorSettings settings;
+        settings.type = InstanceType::Chain;
+        settings.numberOfVariables = numberOfVariables;
+        settings.numberOfComponents = 4;
+        auto clauses = GenerateProblem(settings).GetClauses();
+        std::vector<std::set<Variable>> partitions(4);
+        std::set<Variable> cutSet;
+        for (Variable variable = 1; variable <= numberOfVariables; variable++) {
+            auto partition = static_cast<size_t>((variable - 1) / componentSize);
+            partitions[partition].insert(variable);
+            if (variable % componentSize == 0 && partition + 1 < partitions.size()) {
+                partitions[partition + 1].insert(variable);
+                cutSet.insert(variable);
+            }
+        }
+        // only cut variables
+        clauses.push_back({10000, -20000});
+        clauses.push_back({-30000});
+        Problem problem(numberOfVariables, std::move(clauses));
+
+        Assignment assignment(numberOfVariables);
+        for (Variable variable = 7; variable <= numberOfVariables; variable += 7) {
+            assignment.SetState(variable, variable % 2 ? VariableState::True : VariableState::False);
+        }
+        auto routeCutClause = [&partitions](const Clause& clause) {
+            for (size_t i = 0; i < partitions.size(); i++) {
+                if (std::all_of(clause.begin(), clause.end(), [&](auto literal) {
+                    return partitions[i].count(ToVariable(literal)) > 0;
+                })) {
+                    return i;
+                }
+            }
+            return ClauseRouter::None;
+        };
+
+        ClauseRouter router(numberOfVariables, partitions, cutSet);
+        Assert::AreEqual<size_t>(ClauseRouter::Cut, router.GetOwner(20000));
+        Assert::AreEqual<size_t>(2, router.GetOwner(20001));
+        auto routed = router.Route(problem, assignment, routeCutClause);
+        Assert::IsTrue(routed.has_value());
+        Assert::AreEqual<size_t>(4, routed->size());
+
+        // sequential routing, in the order of the problem
+        std::vector<std::vector<size_t>> expectedIndices(partitions.size());
+        std::vector<std::vector<Clause>> expectedClauses(partitions.size());
+        const auto& problemClauses = problem.GetClauses();
+        std::vector<size_t> owners(problemClauses.size(), 0);
+        for (size_t i = 0; i < problemClauses.size(); i++) {
+            const auto& clause = problemClauses[i];
+            if (std::any_of(clause.begin(), clause.end(), [&assignment](auto literal) {
+                return assignment.IsSAT(literal);
+            })) {
+                continue;
+            }
+            auto target = ClauseRouter::None;
+            Clause simplified;
+            for (auto literal : clause) {
+                if (cutSet.count(ToVariable(literal)) == 0) {
+                    target = static_cast<size_t>((ToVariable(literal) - 1) / componentSize);
+                }
+                if (!assignment.IsSAT(Negate(literal))) {
+                    simplified.push_back(literal);
+                }
+            }
+            if (target == ClauseRouter::None) {
+                target = routeCutClause(clause);
+            }
+            expectedIndices[target].push_back(i);
+            expectedClauses[target].push_back(std::move(simplified));
+        }
+
+        for (size_t partition = 0; partition < partitions.size(); partition++) {
+            const auto& clausesOfPartition = routed.value()[partition];
+            Assert::IsTrue(clausesOfPartition.indices == expectedIndices[partition]);
+            Assert::IsTrue(clausesOfPartition.ToClauses() == expectedClauses[partition]);
+            for (auto index : clausesOfPartition.indices) {
+                owners[index]++;
+            }
+        }
+        // every clause is routed once, except the satisfied ones
+        for (size_t i = 0; i < problemClauses.size(); i++) {
+            auto satisfied = std::any_of(problemClauses[i].begin(), problemClauses[i].end(), [&assignment](auto literal) {
+                return assignment.IsSAT(literal);
+            });
+            Assert::AreEqual<size_t>(satisfied ? 0 : 1, owners[i]);
+        }
+    }
+
+    TEST_METHOD(TestClauseRouter_Invalid)
+    {
+        std::vector<std::set<Variable>> partitions = {{1, 2, 3}, {3, 4, 5}};
+        ClauseRouter router(6, partitions, {3});
+        Assignment assignment(6);
+        auto noPartition = [](const Clause&) {
+            return ClauseRouter::None;
+        };
+
+        // the clause spans two partitions
+        Assert::IsFalse(router.Route(Problem(6, {{1, 4}}), assignment, noPartition).has_value());
+        // 6 is in no partition
+        Assert::IsFalse(router.Route(Problem(6, {{1, 6}}), assignment, noPartition).has_value());
+        // no partition takes the clause of the cut set
+        Assert::IsFalse(router.Route(Problem(6, {{3}}), assignment, noPartition).has_value());
+
+        // satisfied clauses are dropped before they are checked
+        assignment.SetState(1, VariableState::True);
+        auto routed = router.Route(Problem(6, {{1, 4}, {2, -3}}), assignment, noPartition);
+        Assert::IsTrue(routed.has_value());
+        Assert::AreEqual<size_t>(1, routed.value()[0].GetNumberOfClauses());
+        Assert::AreEqual<size_t>(0, routed.value()[1].GetNumberOfClauses());
+    }
+};
+}
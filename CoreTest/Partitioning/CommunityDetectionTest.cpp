@@ -0,0 +1,111 @@
+#include "CoreTest/stdafx.h"
+#include "CppUnitTest.h"
+
+#include <algorithm>
+#include <set>
+
+#include "Core/Utility/InstanceGenerator.h"
+#include "Partitioning/Utility/CommunityDetection.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace CoreTest {
+/// <summary>
+/// number of variables that occur in more than one block
+/// </summary>
+static size_t GetCutSize(const std::vector<Clause>& clauses, const std::vector<size_t>& blocks)
+{
+    std::vector<std::set<size_t>> blocksOfVariables;
+    for (size_t i = 0; i < clauses.size(); i++) {
+        for (auto literal : clauses[i]) {
+            auto variable = static_cast<size_t>(ToVariable(literal));
+            if (variable >= blocksOfVariables.size()) {
+                blocksOfVariables.resize(variable + 1);
+            }
+            blocksOfVariables[variable].insert(blocks[i]);
+        }
+    }
+    return std::count_if(blocksOfVariables.begin(), blocksOfVariables.end(), [](const auto& blocksOfVariable) {
+        return blocksOfVariable.size() > 1;
+    });
+}
+
+TEST_CLASS(CommunityDetectionTest)
+{
+public:
+
+    TEST_METHOD(TestCommunityDetection_PlantedCommunities)
+    {
+        // every triple of 1..5 and of 6..10 is a clause, {5, 6} is the only edge between them
+        std::vector<Clause> clauses;
+        for (Variable first : {1, 6}) {
+            for (Variable a = first; a < first + 5; a++) {
+                for (Variable b = a + 1; b < first + 5; b++) {
+                    for (Variable c = b + 1; c < first + 5; c++) {
+                        clauses.push_back({a, -b, c});
+                    }
+                }
+            }
+        }
+        clauses.push_back({5, 6});
+
+        auto graph = CreateVariableIncidenceGraph(10, clauses);
+        auto communities = FindCommunities(graph, []() {});
+        Assert::AreEqual<size_t>(10, communities.size());
+        for (size_t v = 1; v < 5; v++) {
+            Assert::AreEqual<size_t>(communities[0], communities[v]);
+            Assert::AreEqual<size_t>(communities[5], communities[5 + v]);
+        }
+        Assert::AreNotEqual<size_t>(communities[0], communities[5]);
+        Assert::IsTrue(FindCommunities(graph, []() {}) == communities);
+
+        // only the connecting clause has variables of both communities
+        auto blocks = AssignClausesToCommunities(clauses, communities);
+        for (size_t i = 0; i + 1 < clauses.size(); i++) {
+            Assert::AreEqual<size_t>(communities[ToVariable(clauses[i][0]) - 1], blocks[i]);
+        }
+        Assert::AreEqual<size_t>(1, GetCutSize(clauses, blocks));
+    }
+
+    TEST_METHOD(TestCommunityDetection_ShrinkBoundary)
+    {
+        // {2, 3} joins the second block, so 2 is no longer cut
+        std::vector<Clause> clauses = {{1, 2}, {2, 3}, {3, 4}, {4, 5}};
+        std::vector<size_t> blocks = {0, 1, 1, 1};
+        ShrinkBoundary(clauses, blocks, 2, 1.0, []() {});
+        Assert::AreEqual<size_t>(0, GetCutSize(clauses, blocks));
+
+        for (uint64_t seed = 0; seed < 10; seed++) {
+            GeneratorSettings settings;
+            settings.type = InstanceType::Community;
+            settings.numberOfVariables = 200;
+            settings.numberOfComponents = 4;
+            settings.seed = seed;
+            auto problem = GenerateProblem(settings);
+            const auto& problemClauses = problem.GetClauses();
+
+            for (size_t numberOfBlocks : {2, 4}) {
+                std::vector<size_t> assigned(problemClauses.size());
+                for (size_t i = 0; i < assigned.size(); i++) {
+                    assigned[i] = i % numberOfBlocks;
+                }
+                std::vector<size_t> sizes(numberOfBlocks, 0);
+                for (auto block : assigned) {
+                    sizes[block]++;
+                }
+                auto cutSize = GetCutSize(problemClauses, assigned);
+
+                ShrinkBoundary(problemClauses, assigned, numberOfBlocks, 0.1, []() {});
+                Assert::IsTrue(GetCutSize(problemClauses, assigned) <= cutSize);
+                std::vector<size_t> shrunkSizes(numberOfBlocks, 0);
+                for (auto block : assigned) {
+                    shrunkSizes[block]++;
+                }
+                for (size_t block = 0; block < numberOfBlocks; block++) {
+                    Assert::IsTrue(shrunkSizes[block] <= static_cast<size_t>(1.1 * sizes[block]) + 1);
+                }
+            }
+        }
+    }
+};
+}
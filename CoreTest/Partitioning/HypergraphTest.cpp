@@ -0,0 +1,104 @@
+#include "CoreTest/stdafx.h"
+#include "CppUnitTest.h"
+
+#include <algorithm>
+#include <set>
+
+#include "Core/Utility/InstanceGenerator.h"
+#include "Partitioning/Utility/Hypergraph.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace CoreTest {
+/// <summary>
+/// number of variables whose clauses are in more than one block
+/// </summary>
+static size_t CountSharedVariables(const Problem& problem, const std::vector<size_t>& blocks)
+{
+    std::vector<std::set<size_t>> blocksOfVariables(static_cast<size_t>(problem.GetNumberOfVariables()) + 1);
+    for (size_t i = 0; i < problem.GetClauses().size(); i++) {
+        for (auto literal : problem.GetClauses()[i]) {
+            blocksOfVariables[ToVariable(literal)].insert(blocks[i]);
+        }
+    }
+    return std::count_if(blocksOfVariables.begin(), blocksOfVariables.end(), [](const auto& blocksOfVariable) {
+        return blocksOfVariable.size() > 1;
+    });
+}
+
+TEST_CLASS(HypergraphTest)
+{
+public:
+
+    TEST_METHOD(TestHypergraph_FromClauses)
+    {
+        // 4 and 5 only occur once, 2 occurs twice in the second clause
+        Problem problem(5, {{1, 2}, {2, -2, 3}, {3, 4}, {-1, 5}});
+        auto hypergraph = Hypergraph::FromClauses(problem);
+
+        Assert::AreEqual<size_t>(4, hypergraph.GetNumberOfVertices());
+        Assert::AreEqual<size_t>(3, hypergraph.GetNumberOfNets());
+        Assert::AreEqual<size_t>(4, hypergraph.GetTotalWeight());
+        Assert::AreEqual<size_t>(2, hypergraph.GetPins(1).size());
+        Assert::AreEqual<size_t>(2, hypergraph.GetNets(1).size());
+
+        Assert::AreEqual<size_t>(0, GetCut(hypergraph, {0, 0, 0, 0}));
+        Assert::AreEqual<size_t>(1, GetCut(hypergraph, {0, 0, 0, 1}));
+        Assert::AreEqual<size_t>(2, GetCut(hypergraph, {0, 0, 1, 1}));
+        Assert::AreEqual<size_t>(3, GetCut(hypergraph, {0, 1, 0, 1}));
+    }
+
+    TEST_METHOD(TestHypergraph_Partition)
+    {
+        const double imbalance = 0.05;
+        for (auto type : {InstanceType::DisjointUnion, InstanceType::Chain, InstanceType::Community, InstanceType::RandomKSAT}) {
+            for (size_t numberOfPartitions : {2, 3, 4}) {
+                GeneratorSettings settings;
+                settings.type = type;
+                settings.numberOfVariables = 400;
+                settings.numberOfComponents = numberOfPartitions;
+                settings.seed = numberOfPartitions;
+                auto problem = GenerateProblem(settings);
+                auto hypergraph = Hypergraph::FromClauses(problem);
+
+                auto blocks = PartitionHypergraph(hypergraph, numberOfPartitions, imbalance, 1, []() {});
+                Assert::IsTrue(PartitionHypergraph(hypergraph, numberOfPartitions, imbalance, 1, []() {}) == blocks);
+
+                // every block within its share
+                std::vector<size_t> weights(numberOfPartitions, 0);
+                for (size_t v = 0; v < blocks.size(); v++) {
+                    Assert::IsTrue(blocks[v] < numberOfPartitions);
+                    weights[blocks[v]] += hypergraph.GetVertexWeight(v);
+                }
+                for (auto weight : weights) {
+                    Assert::IsTrue(weight <= (1.0 + imbalance) * hypergraph.GetTotalWeight() / numberOfPartitions);
+                }
+
+                // a cut net is a variable shared by two blocks
+                auto cut = GetCut(hypergraph, blocks);
+                Assert::AreEqual<size_t>(CountSharedVariables(problem, blocks), cut);
+                if (type == InstanceType::DisjointUnion) {
+                    Assert::AreEqual<size_t>(0, cut);
+                } else if (type == InstanceType::Chain) {
+                    // only the links between the components
+                    Assert::IsTrue(cut <= numberOfPartitions - 1);
+                } else {
+                    std::vector<size_t> roundRobin(blocks.size());
+                    for (size_t v = 0; v < roundRobin.size(); v++) {
+                        roundRobin[v] = v % numberOfPartitions;
+                    }
+                    Assert::IsTrue(cut < GetCut(hypergraph, roundRobin));
+                }
+            }
+        }
+    }
+
+    TEST_METHOD(TestHypergraph_Invalid)
+    {
+        auto hypergraph = Hypergraph::FromClauses(Problem(2, {{1, 2}, {-1, 2}}));
+        Assert::ExpectException<std::invalid_argument>([&hypergraph]() {
+            PartitionHypergraph(hypergraph, 0, 0.05, 1, []() {});
+        });
+    }
+};
+}
@@ -0,0 +1,44 @@
+#include "CoreTest/stdafx.h"
+#include "CppUnitTest.h"
+
+#include "Core/Utility/BitSlicedSolver.h"
+#include "Core/Utility/InstanceGenerator.h"
+#include "Partitioning/Algorithm/MultilevelPartitioner.h"
+#include "Partitioning/Algorithm/OnePointPartitioner.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace CoreTest {
+TEST_CLASS(OnePointPartitionerTest)
+{
+public:
+
+    TEST_METHOD(TestOnePointPartitioner_Recursive)
+    {
+        // nested partitioners return partial models, the merged model must still be complete
+        for (uint64_t seed = 1020; seed < 1060; seed++) {
+            GeneratorSettings settings;
+            settings.type = InstanceType::Chain;
+            settings.numberOfVariables = 21;
+            settings.numberOfComponents = 3;
+            settings.ratio = 2.9;
+            settings.seed = seed;
+            auto problem = GenerateProblem(settings);
+
+            OnePointPartitioner partitioner;
+            partitioner.SetPartitionSolver(std::make_shared<BitSlicedSolver>());
+            partitioner.SetRecursion([]() {
+                return std::make_shared<MultilevelPartitioner>();
+            }, 4, 3);
+            partitioner.SetBitSlicedThreshold(0);
+
+            auto expected = BitSlicedSolver().Solve(problem, {});
+            auto solution = partitioner.Solve(problem, {});
+            Assert::IsTrue(solution.first == expected.first);
+            if (solution.first == SolvingResult::Satisfiable) {
+                Assert::IsTrue(problem.Apply(solution.second.value()) == SolvingResult::Satisfiable);
+            }
+        }
+    }
+};
+}
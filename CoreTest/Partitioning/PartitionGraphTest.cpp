@@ -0,0 +1,226 @@
+#include "CoreTest/stdafx.h"
+#include "CppUnitTest.h"
+
+#include <algorithm>
+#include <optional>
+#include <set>
+
+#include "Partitioning/Utility/PartitionGraph.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace CoreTest {
+/// <summary>
+/// The pairwise scans over the partition vector that PartitionGraph replaced.
+/// </summary>
+namespace Reference {
+static size_t GetConnectivity(const Partition& l, const Partition& r)
+{
+    size_t connectivity = 0;
+    for (auto variable : l.variables) {
+        connectivity += r.variables.count(variable);
+    }
+    return connectivity;
+}
+
+static void MergePartitions(std::vector<Partition>& partitions, size_t& into, size_t& from)
+{
+    partitions[into].clauses.insert(partitions[into].clauses.end(), partitions[from].clauses.begin(), partitions[from].clauses.end());
+    partitions[into].variables.insert(partitions[from].variables.begin(), partitions[from].variables.end());
+    partitions.erase(partitions.begin() + from);
+    if (from < into) {
+        into--;
+    }
+    from--;
+}
+
+static void MergePartitionsC2(std::vector<Partition>& partitions)
+{
+    for (size_t i = 0; i < partitions.size(); i++) {
+        for (size_t j = 0; j < partitions.size(); j++) {
+            if (i != j && GetConnectivity(partitions[i], partitions[j]) >= 2) {
+                MergePartitions(partitions, i, j);
+            }
+        }
+    }
+}
+
+static std::vector<Clause> MergeClauses1(std::vector<Partition>& partitions)
+{
+    std::vector<Clause> looseClauses;
+    for (size_t i = 0; i < partitions.size(); i++) {
+        if (partitions[i].clauses.size() > 1) {
+            continue;
+        }
+        std::optional<size_t> candidatePartition;
+        bool isConnectedClause = false;
+        bool hasMany = false;
+        for (size_t j = 0; j < partitions.size(); j++) {
+            if (i == j || GetConnectivity(partitions[i], partitions[j]) == 0) {
+                continue;
+            }
+            if (candidatePartition.has_value() && !isConnectedClause) {
+                hasMany = true;
+                break;
+            }
+            candidatePartition = j;
+            isConnectedClause = partitions[j].clauses.size() == 1;
+        }
+        if (!candidatePartition.has_value()) {
+            looseClauses.push_back(std::move(partitions[i].clauses[0]));
+            partitions.erase(partitions.begin() + i);
+            i--;
+        } else if (!hasMany) {
+            MergePartitions(partitions, candidatePartition.value(), i);
+        }
+    }
+    return looseClauses;
+}
+
+static void MergeConnections(std::vector<Partition>& partitions)
+{
+    std::stable_sort(partitions.begin(), partitions.end(), [](const auto& l, const auto& r) {
+        return l.clauses.size() < r.clauses.size();
+    });
+    for (size_t i = 0; i < partitions.size(); i++) {
+        if (partitions[i].clauses.size() != 1) {
+            continue;
+        }
+        for (size_t j = 0; j < partitions.size(); j++) {
+            if (i != j && GetConnectivity(partitions[i], partitions[j]) >= 1) {
+                MergePartitions(partitions, j, i);
+                break;
+            }
+        }
+    }
+}
+}
+
+static std::vector<Partition> CreatePartitions(const std::vector<Clause>& clauses)
+{
+    std::vector<Partition> partitions;
+    for (const auto& clause : clauses) {
+        std::pmr::set<Variable> variables;
+        for (auto literal : clause) {
+            variables.insert(ToVariable(literal));
+        }
+        partitions.emplace_back(std::vector<Clause>{clause}, std::move(variables));
+    }
+    return partitions;
+}
+
+/// <summary>
+/// clauses of each partition, sorted, in the order of the partitions
+/// </summary>
+static std::vector<std::vector<Clause>> Normalize(const std::vector<Partition>& partitions)
+{
+    std::vector<std::vector<Clause>> normalized;
+    for (const auto& partition : partitions) {
+        auto clauses = partition.clauses;
+        std::sort(clauses.begin(), clauses.end());
+        normalized.push_back(std::move(clauses));
+    }
+    return normalized;
+}
+
+/// <summary>
+/// runs the first phases of OnePointPartitioner::MergePartitions with the graph and the reference
+/// </summary>
+static void AssertSameMerge(Variable numberOfVariables, const std::vector<Clause>& clauses, size_t phases)
+{
+    auto noLimit = []() {};
+    PartitionGraph graph(numberOfVariables, CreatePartitions(clauses));
+    auto expected = CreatePartitions(clauses);
+    std::vector<Clause> looseClauses;
+    std::vector<Clause> expectedLooseClauses;
+    for (size_t phase = 0; phase < phases; phase++) {
+        if (phase == 1) {
+            looseClauses = graph.MergeSingleClauses(noLimit);
+            expectedLooseClauses = Reference::MergeClauses1(expected);
+        } else if (phase == 3) {
+            graph.MergeConnections(noLimit);
+            Reference::MergeConnections(expected);
+        } else {
+            graph.MergeSharedPairs(noLimit);
+            Reference::MergePartitionsC2(expected);
+        }
+    }
+
+    Assert::IsTrue(Normalize(graph.ExtractPartitions()) == Normalize(expected));
+    Assert::IsTrue(looseClauses == expectedLooseClauses);
+}
+
+TEST_CLASS(PartitionGraphTest)
+{
+public:
+
+    TEST_METHOD(TestPartitionGraph_SharedPairs)
+    {
+        // {1, 2} links the first and the third clause, the third clause reaches the fourth only after the merge
+        std::vector<Clause> clauses = {{1, 2, 3}, {4, 5, 6}, {-1, -2, 7}, {7, -3, 8}, {4, 9}, {-5, 6, 9}};
+        PartitionGraph graph(9, CreatePartitions(clauses));
+        graph.MergeSharedPairs([]() {});
+        auto partitions = graph.ExtractPartitions();
+
+        Assert::AreEqual<size_t>(2, partitions.size());
+        Assert::AreEqual<size_t>(3, partitions[0].clauses.size());
+        Assert::AreEqual<size_t>(3, partitions[1].clauses.size());
+        for (size_t phases = 1; phases <= 5; phases++) {
+            AssertSameMerge(9, clauses, phases);
+        }
+    }
+
+    TEST_METHOD(TestPartitionGraph_SingleClauses)
+    {
+        // {4, 9} comes after the partition of 1..4, {9, 10} is connected with two partitions,
+        // {11, 12} is loose, {13, 14} and {14, 15} are only connected with each other
+        std::vector<Clause> clauses = {
+            {1, 2, 3}, {-1, -2, 4}, {2, 3, -4},
+            {5, 6, 7}, {-5, -6, 8}, {6, 7, 8},
+            {4, 9}, {9, 10}, {10, 5}, {11, 12}, {13, 14}, {14, 15}
+        };
+        for (size_t phases = 1; phases <= 5; phases++) {
+            AssertSameMerge(15, clauses, phases);
+        }
+
+        PartitionGraph graph(15, CreatePartitions(clauses));
+        graph.MergeSharedPairs([]() {});
+        auto looseClauses = graph.MergeSingleClauses([]() {});
+        Assert::AreEqual<size_t>(1, looseClauses.size());
+        Assert::IsTrue(looseClauses[0] == Clause{11, 12});
+    }
+
+    TEST_METHOD(TestPartitionGraph_Connections)
+    {
+        // the connections are merged into the smaller partition, {3, 9} and {9, 6} go with {4, 9} into the first one
+        std::vector<Clause> clauses = {
+            {1, 2, 3}, {-1, -2, 3}, {1, 2, -3},
+            {4, 5, 6}, {-4, -5, 6}, {4, 5, -6}, {4, -5, -6},
+            {3, 9}, {9, 6}, {3, 6}, {1, 4}
+        };
+        for (size_t phases = 1; phases <= 5; phases++) {
+            AssertSameMerge(9, clauses, phases);
+        }
+    }
+
+    TEST_METHOD(TestPartitionGraph_Chains)
+    {
+        // rings of clauses that share one variable with the next one, joined by connections
+        std::vector<Clause> clauses;
+        for (Variable ring = 0; ring < 4; ring++) {
+            auto first = ring * 10 + 1;
+            for (Variable i = 0; i < 6; i++) {
+                clauses.push_back({first + i, -(first + (i + 1) % 6), first + 6 + i % 2});
+            }
+        }
+        clauses.push_back({1, 11});
+        clauses.push_back({12, -21});
+        clauses.push_back({22, 31});
+        clauses.push_back({32, -1});
+        clauses.push_back({3, -33});
+        for (size_t phases = 1; phases <= 5; phases++) {
+            AssertSameMerge(40, clauses, phases);
+        }
+    }
+};
+}
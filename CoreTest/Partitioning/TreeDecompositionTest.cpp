@@ -0,0 +1,151 @@
+#include "CoreTest/stdafx.h"
+#include "CppUnitTest.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "Core/Utility/InstanceGenerator.h"
+#include "Partitioning/Algorithm/TreeDecompositionPartitioner.h"
+#include "Partitioning/Utility/TreeDecomposition.h"
+#include "SifferDP/SifferDPSolver.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace CoreTest {
+/// <summary>
+/// checks the properties documented at TreeDecomposition
+/// </summary>
+static void AssertValid(const Problem& problem, const TreeDecomposition& decomposition, size_t maxSeparatorSize)
+{
+    auto numberOfBags = decomposition.GetNumberOfBags();
+    Assert::AreEqual<size_t>(numberOfBags, decomposition.parents.size());
+    Assert::AreEqual<size_t>(numberOfBags, decomposition.clauses.size());
+
+    // every clause belongs to exactly one bag that contains its variables
+    std::vector<size_t> owners(problem.GetClauses().size(), 0);
+    for (size_t bag = 0; bag < numberOfBags; bag++) {
+        const auto& variables = decomposition.bags[bag];
+        Assert::IsTrue(std::is_sorted(variables.begin(), variables.end()));
+        for (auto index : decomposition.clauses[bag]) {
+            owners[index]++;
+            for (auto literal : problem.GetClauses()[index]) {
+                Assert::IsTrue(std::binary_search(variables.begin(), variables.end(), ToVariable(literal)));
+            }
+        }
+    }
+    for (auto owner : owners) {
+        Assert::AreEqual<size_t>(1, owner);
+    }
+
+    // children first, the separator is the intersection with the parent
+    for (size_t bag = 0; bag < numberOfBags; bag++) {
+        auto parent = decomposition.parents[bag];
+        if (parent == TreeDecomposition::None) {
+            Assert::IsTrue(decomposition.GetSeparator(bag).empty());
+            continue;
+        }
+        Assert::IsTrue(parent > bag && parent < numberOfBags);
+        std::vector<Variable> shared;
+        std::set_intersection(decomposition.bags[bag].begin(), decomposition.bags[bag].end(),
+            decomposition.bags[parent].begin(), decomposition.bags[parent].end(), std::back_inserter(shared));
+        Assert::IsTrue(decomposition.GetSeparator(bag) == shared);
+        Assert::IsTrue(shared.size() <= maxSeparatorSize);
+    }
+
+    // running intersection: the bags of a variable form one subtree, so only its top bag lacks it in the parent
+    std::vector<size_t> tops(static_cast<size_t>(problem.GetNumberOfVariables()) + 1, 0);
+    for (size_t bag = 0; bag < numberOfBags; bag++) {
+        auto parent = decomposition.parents[bag];
+        for (auto variable : decomposition.bags[bag]) {
+            if (parent == TreeDecomposition::None
+                || !std::binary_search(decomposition.bags[parent].begin(), decomposition.bags[parent].end(), variable)) {
+                tops[variable]++;
+            }
+        }
+    }
+    for (auto top : tops) {
+        Assert::IsTrue(top <= 1);
+    }
+}
+
+/// <summary>
+/// planted, so it is satisfiable
+/// </summary>
+static Problem CreateChain(uint64_t seed)
+{
+    GeneratorSettings settings;
+    settings.type = InstanceType::Chain;
+    settings.numberOfVariables = 60;
+    settings.numberOfComponents = 6;
+    settings.ratio = 4.0;
+    settings.seed = seed;
+    settings.planted = true;
+    return GenerateProblem(settings);
+}
+
+TEST_CLASS(TreeDecompositionTest)
+{
+public:
+
+    TEST_METHOD(TestTreeDecomposition_Properties)
+    {
+        for (auto type : {InstanceType::Chain, InstanceType::Community}) {
+            for (auto heuristic : {EliminationHeuristic::MinDegree, EliminationHeuristic::MinFill}) {
+                for (size_t minClausesPerBag : {1, 8, 64}) {
+                    GeneratorSettings settings;
+                    settings.type = type;
+                    settings.numberOfVariables = 30;
+                    settings.numberOfComponents = 3;
+                    settings.ratio = 2.5;
+                    settings.seed = minClausesPerBag;
+                    auto problem = GenerateProblem(settings);
+
+                    auto decomposition = DecomposeTree(problem, heuristic, 10, minClausesPerBag, []() {});
+                    Assert::IsTrue(decomposition.has_value());
+                    Assert::IsTrue(decomposition->GetNumberOfBags() > 1);
+                    AssertValid(problem, decomposition.value(), 10);
+                }
+            }
+        }
+    }
+
+    TEST_METHOD(TestTreeDecomposition_TooWide)
+    {
+        GeneratorSettings settings;
+        settings.numberOfVariables = 60;
+        auto problem = GenerateProblem(settings);
+        Assert::IsFalse(DecomposeTree(problem, EliminationHeuristic::MinFill, 2, 1, []() {}).has_value());
+    }
+
+    TEST_METHOD(TestTreeDecompositionPartitioner_Satisfiable)
+    {
+        for (uint64_t seed = 0; seed < 4; seed++) {
+            auto problem = CreateChain(seed);
+            Assert::IsTrue(DecomposeTree(problem, EliminationHeuristic::MinFill, 10, 64, []() {})->GetNumberOfBags() > 1);
+
+            TreeDecompositionPartitioner partitioner;
+            partitioner.SetPartitionSolver(std::make_shared<SifferDPSolver>());
+            auto solution = partitioner.Solve(problem, {});
+            Assert::IsTrue(solution.first == SolvingResult::Satisfiable);
+            Assert::IsTrue(problem.Apply(solution.second.value()) == SolvingResult::Satisfiable);
+        }
+    }
+
+    TEST_METHOD(TestTreeDecompositionPartitioner_Unsatisfiable)
+    {
+        for (uint64_t seed = 0; seed < 4; seed++) {
+            // all sign combinations of three variables of the first component can not be satisfied
+            auto clauses = CreateChain(seed).GetClauses();
+            for (Literal signs = 0; signs < 8; signs++) {
+                clauses.push_back({signs & 1 ? 1 : -1, signs & 2 ? 2 : -2, signs & 4 ? 3 : -3});
+            }
+            Problem problem(60, std::move(clauses));
+
+            TreeDecompositionPartitioner partitioner;
+            partitioner.SetPartitionSolver(std::make_shared<SifferDPSolver>());
+            auto solution = partitioner.Solve(problem, {});
+            Assert::IsTrue(solution.first == SolvingResult::Unsatisfiable);
+        }
+    }
+};
+}
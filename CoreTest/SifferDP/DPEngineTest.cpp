@@ -0,0 +1,165 @@
+#include "CoreTest/stdafx.h"
+#include "CppUnitTest.h"
+
+#include "Core/Utility/BitSlicedSolver.h"
+#include "Core/Utility/InstanceGenerator.h"
+#include "SifferDP/Details/DPEngine.h"
+#include "SifferDP/SifferDPSolver.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace std::chrono_literals;
+
+namespace CoreTest {
+TEST_CLASS(DPEngineTest)
+{
+public:
+
+    TEST_METHOD(TestDPEngine_Random)
+    {
+        // below and above the threshold, so both results occur
+        for (auto ratio : {3.0, 6.0}) {
+            for (uint64_t seed = 0; seed < 20; seed++) {
+                GeneratorSettings settings;
+                settings.numberOfVariables = 16;
+                settings.ratio = ratio;
+                settings.seed = seed;
+                auto problem = GenerateProblem(settings);
+
+                auto expected = BitSlicedSolver().Solve(problem, {});
+                DPEngine engine(problem.GetNumberOfVariables(), problem.GetClauses());
+                auto sat = engine.Solve({});
+                Assert::IsTrue(sat.has_value());
+                Assert::IsTrue(sat.value() == (expected.first == SolvingResult::Satisfiable));
+            }
+        }
+    }
+
+    TEST_METHOD(TestDPEngine_EmptyResolvent)
+    {
+        // eliminating 1 resolves {2} and {-2}, the second one is empty under the first one
+        DPEngine engine(2, {{1, 2}, {1, -2}, {-1, 2}, {-1, -2}});
+        auto sat = engine.Solve({});
+
+        Assert::IsTrue(sat.has_value());
+        Assert::IsFalse(sat.value());
+        Assert::AreEqual<size_t>(1, engine.GetNumberOfEliminations());
+        Assert::AreEqual<size_t>(2, engine.GetNumberOfResolvents());
+
+        // conflicting units do not need an elimination
+        DPEngine units(1, {{1}, {-1}});
+        Assert::IsFalse(units.Solve({}).value());
+        Assert::AreEqual<size_t>(0, units.GetNumberOfEliminations());
+    }
+
+    TEST_METHOD(TestDPEngine_Tautologies)
+    {
+        // the only clause is a tautology, nothing is left to eliminate
+        DPEngine input(2, {{1, -1, 2}});
+        Assert::IsTrue(input.Solve({}).value());
+        Assert::AreEqual<size_t>(0, input.GetNumberOfEliminations());
+
+        // the only resolvent {2, -2} is dropped
+        DPEngine resolvent(2, {{1, 2}, {-1, -2}});
+        Assert::IsTrue(resolvent.Solve({}).value());
+        Assert::AreEqual<size_t>(1, resolvent.GetNumberOfEliminations());
+        Assert::AreEqual<size_t>(0, resolvent.GetNumberOfResolvents());
+    }
+
+    TEST_METHOD(TestDPEngine_Subsumption)
+    {
+        // 1 is eliminated first, its resolvent {2, 3} removes {2, 3, 4}
+        DPEngine removes(5, {{1, 2, 3}, {-1, 2, 3}, {2, 3, 4}, {-2, -3, 5}, {-2, -3, -5}});
+        Assert::IsTrue(removes.Solve({}).value());
+        Assert::AreEqual<size_t>(1, removes.GetNumberOfSubsumed());
+
+        // the resolvent {2, 3} already exists and is dropped
+        DPEngine dropped(5, {{1, 2, 3}, {-1, 2, 3}, {2, 3}, {-2, -3, 5}, {-2, -3, -5}});
+        Assert::IsTrue(dropped.Solve({}).value());
+        Assert::AreEqual<size_t>(1, dropped.GetNumberOfSubsumed());
+
+        DPEngine none(2, {{1, 2}, {-1, -2}});
+        none.Solve({});
+        Assert::AreEqual<size_t>(0, none.GetNumberOfSubsumed());
+    }
+
+    TEST_METHOD(TestDPEngine_GiveUp)
+    {
+        DPSettings shortResolvents;
+        shortResolvents.maxResolventLength = 1;
+        DPEngine tooLong(5, {{1, 2, 3}, {-1, 4, 5}}, shortResolvents);
+        Assert::IsFalse(tooLong.Solve({}).has_value());
+        Assert::ExpectException<std::runtime_error>([&tooLong]() {
+            tooLong.GetModel();
+        });
+
+        // random 3-SAT at the threshold grows beyond its initial number of clauses
+        GeneratorSettings settings;
+        settings.numberOfVariables = 40;
+        auto problem = GenerateProblem(settings);
+        DPSettings noGrowth;
+        noGrowth.maxClauseGrowth = 1;
+        noGrowth.minClauseLimit = 0;
+        DPEngine tooMany(problem.GetNumberOfVariables(), problem.GetClauses(), noGrowth);
+        Assert::IsFalse(tooMany.Solve({}).has_value());
+
+        // the solver reports giving up as undefined
+        auto solution = SifferDPSolver().Solve(problem, 0ms);
+        Assert::IsTrue(solution.first == SolvingResult::Undefined);
+        Assert::IsFalse(solution.second.has_value());
+    }
+
+    TEST_METHOD(TestDPEngine_Model)
+    {
+        size_t models = 0;
+        for (auto type : {InstanceType::RandomKSAT, InstanceType::Chain, InstanceType::Community}) {
+            for (uint64_t seed = 0; seed < 20; seed++) {
+                GeneratorSettings settings;
+                settings.type = type;
+                settings.numberOfVariables = 40;
+                settings.numberOfComponents = 4;
+                settings.ratio = 3.5;
+                settings.seed = seed;
+                auto problem = GenerateProblem(settings);
+
+                DPEngine engine(problem.GetNumberOfVariables(), problem.GetClauses());
+                auto sat = engine.Solve({});
+                if (sat.value_or(false)) {
+                    Assert::IsTrue(problem.Apply(engine.GetModel()) == SolvingResult::Satisfiable);
+                    models++;
+                }
+            }
+        }
+        Assert::IsTrue(models > 30);
+    }
+
+    TEST_METHOD(TestDPEngine_PureLiterals)
+    {
+        // 1 only occurs positive and is eliminated first without resolvents, 6 only occurs negative,
+        // the model has to set 1 for the clauses that the later variables leave unsatisfied
+        Problem problem(6, {{1, 2}, {1, -3}, {1, 4, -6}, {-2, 3, 4}, {-4, 5}, {2, -5, -6}, {-2, -4, -5}});
+        DPEngine engine(problem.GetNumberOfVariables(), problem.GetClauses());
+        Assert::IsTrue(engine.Solve({}).value());
+        Assert::IsTrue(problem.Apply(engine.GetModel()) == SolvingResult::Satisfiable);
+
+        // units fix 1 and 2 first, 3 is pure afterwards
+        Problem fixed(4, {{1}, {-1, 2}, {-2, 3, 4}, {3, -4}, {-1, 3}});
+        DPEngine units(fixed.GetNumberOfVariables(), fixed.GetClauses());
+        Assert::IsTrue(units.Solve({}).value());
+        Assert::IsTrue(fixed.Apply(units.GetModel()) == SolvingResult::Satisfiable);
+    }
+
+    TEST_METHOD(TestDPEngine_NoModel)
+    {
+        DPEngine unsolved(2, {{1, 2}, {-1, 2}});
+        Assert::ExpectException<std::runtime_error>([&unsolved]() {
+            unsolved.GetModel();
+        });
+
+        DPEngine unsatisfiable(2, {{1, 2}, {1, -2}, {-1, 2}, {-1, -2}});
+        Assert::IsFalse(unsatisfiable.Solve({}).value());
+        Assert::ExpectException<std::runtime_error>([&unsatisfiable]() {
+            unsatisfiable.GetModel();
+        });
+    }
+};
+}
@@ -0,0 +1,94 @@
+#include "CoreTest/stdafx.h"
+#include "CppUnitTest.h"
+
+#include "Core/Utility/BitSlicedSolver.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace CoreTest {
+TEST_CLASS(BitSlicedSolverTest)
+{
+public:
+
+    TEST_METHOD(TestBitSlicedSolver_Satisfiable)
+    {
+        Problem p(1000, {{3, -500}, {-3, 1000}, {-1000, -500}, {500, 7}});
+
+        auto solution = BitSlicedSolver().Solve(p, {});
+
+        Assert::IsTrue(solution.first == SolvingResult::Satisfiable);
+        Assert::IsTrue(p.Apply(solution.second.value()) == SolvingResult::Satisfiable);
+    }
+
+    TEST_METHOD(TestBitSlicedSolver_Unsatisfiable)
+    {
+        Problem p(3, {{1, 2}, {-1, 2}, {1, -2}, {-1, -2, 3}, {-1, -2, -3}});
+
+        auto solution = BitSlicedSolver().Solve(p, {});
+
+        Assert::IsTrue(solution.first == SolvingResult::Unsatisfiable);
+    }
+
+    TEST_METHOD(TestBitSlicedSolver_BlockVariables)
+    {
+        // the only model sets all variables, including the ones that are constant per block
+        std::vector<Clause> clauses{{1}};
+        for (Variable variable = 1; variable < 14; variable++) {
+            clauses.push_back({-variable, variable + 1});
+        }
+        Problem p(14, clauses);
+
+        auto solution = BitSlicedSolver().Solve(p, {});
+
+        Assert::IsTrue(solution.first == SolvingResult::Satisfiable);
+        for (Variable variable = 1; variable <= 14; variable++) {
+            Assert::IsTrue(solution.second->GetState(variable) == VariableState::True);
+        }
+    }
+
+    TEST_METHOD(TestBitSlicedSolver_Projections)
+    {
+        // 1 and 12 must differ, 5 is free, 7 does not occur
+        Problem p(12, {{1, 12}, {-1, -12}, {5, 2}, {-2, 3}});
+
+        auto projections = BitSlicedSolver().EnumerateProjections(p, {1, 12, 5, 7}, {});
+
+        Assert::IsTrue(projections.first == SolvingResult::Satisfiable);
+        Assert::AreEqual<size_t>(4, projections.second.size());
+        for (const auto& witness : projections.second) {
+            Assert::IsTrue(p.Apply(witness) == SolvingResult::Satisfiable);
+        }
+
+        // the same projections by blocking clauses
+        auto blocked = SATSolver::EnumerateByBlocking(p, {1, 12, 5, 7}, {}, [](const auto& problem, auto timeLimit) {
+            return BitSlicedSolver().Solve(problem, timeLimit);
+        });
+        Assert::IsTrue(blocked.first == SolvingResult::Satisfiable);
+        Assert::AreEqual<size_t>(4, blocked.second.size());
+    }
+
+    TEST_METHOD(TestBitSlicedSolver_NoProjections)
+    {
+        Problem p(2, {{1, 2}, {-1, 2}, {1, -2}, {-1, -2}});
+
+        auto projections = BitSlicedSolver().EnumerateProjections(p, {1}, {});
+
+        Assert::IsTrue(projections.first == SolvingResult::Unsatisfiable);
+        Assert::IsTrue(projections.second.empty());
+    }
+
+    TEST_METHOD(TestBitSlicedSolver_TooManyVariables)
+    {
+        std::vector<Clause> clauses;
+        for (Variable variable = 1; variable <= BitSlicedSolver::MaxVariables + 1; variable++) {
+            clauses.push_back({variable});
+        }
+        Problem p(BitSlicedSolver::MaxVariables + 1, clauses);
+
+        Assert::AreEqual(BitSlicedSolver::MaxVariables + 1, BitSlicedSolver::GetNumberOfUsedVariables(p));
+        Assert::ExpectException<std::invalid_argument>([&p]() {
+            BitSlicedSolver().Solve(p, {});
+        });
+    }
+};
+}
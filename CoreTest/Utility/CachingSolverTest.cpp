@@ -0,0 +1,156 @@
+#include "CoreTest/stdafx.h"
+#include "CppUnitTest.h"
+
+#include <filesystem>
+
+#include "Core/Utility/BitSlicedSolver.h"
+#include "Core/Utility/CachingSolver.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace CoreTest {
+class CountingSolver : public SATSolver {
+public:
+    size_t calls = 0;
+
+    virtual Solution Solve(const Problem& problem, OptionalTimeLimitMs timeLimit) override
+    {
+        calls++;
+        return BitSlicedSolver().Solve(problem, timeLimit);
+    }
+};
+
+/// <summary>
+/// empty store directory, removed at the end of the test
+/// </summary>
+struct TemporaryDirectory {
+    std::filesystem::path path;
+
+    explicit TemporaryDirectory(const std::string& name) :
+        path(std::filesystem::temp_directory_path() / name)
+    {
+        std::filesystem::remove_all(path);
+    }
+
+    ~TemporaryDirectory()
+    {
+        std::filesystem::remove_all(path);
+    }
+};
+
+TEST_CLASS(CachingSolverTest)
+{
+public:
+
+    TEST_METHOD(TestCachingSolver_Hit)
+    {
+        TemporaryDirectory directory("woipv-caching-solver-hit");
+        auto counting = std::make_shared<CountingSolver>();
+        CachingSolver solver(counting, "Counting", std::make_shared<SolutionStore>(directory.path));
+        Problem p(10, {{1, -2}, {2, 3}, {-3, -1}});
+        // the same clauses in another order, with other variables
+        Problem shifted(20, {{12, 13}, {-13, -11}, {-12, 11}, {11, -12}});
+
+        auto first = solver.Solve(p, {});
+        auto second = solver.Solve(shifted, {});
+
+        Assert::AreEqual<size_t>(1, counting->calls);
+        Assert::AreEqual<size_t>(1, solver.GetHits());
+        Assert::AreEqual<size_t>(1, solver.GetMisses());
+        Assert::IsTrue(first.first == SolvingResult::Satisfiable);
+        Assert::IsTrue(second.first == SolvingResult::Satisfiable);
+        Assert::IsTrue(shifted.Apply(second.second.value()) == SolvingResult::Satisfiable);
+    }
+
+    TEST_METHOD(TestCachingSolver_Persistent)
+    {
+        TemporaryDirectory directory("woipv-caching-solver-persistent");
+        Problem p(2, {{1, 2}, {-1, 2}, {1, -2}, {-1, -2}});
+        {
+            CachingSolver solver(std::make_shared<CountingSolver>(), "Counting", std::make_shared<SolutionStore>(directory.path));
+            Assert::IsTrue(solver.Solve(p, {}).first == SolvingResult::Unsatisfiable);
+        }
+
+        // another store on the same directory, like another process
+        auto store = std::make_shared<SolutionStore>(directory.path);
+        auto counting = std::make_shared<CountingSolver>();
+        CachingSolver solver(counting, "Counting", store);
+        Assert::IsTrue(solver.Solve(p, {}).first == SolvingResult::Unsatisfiable);
+        Assert::AreEqual<size_t>(0, counting->calls);
+
+        // unsatisfiable is not trusted from other solvers
+        CachingSolver other(counting, "Other", store);
+        Assert::IsTrue(other.Solve(p, {}).first == SolvingResult::Unsatisfiable);
+        Assert::AreEqual<size_t>(1, counting->calls);
+        Assert::AreEqual<size_t>(1, other.GetMisses());
+    }
+
+    TEST_METHOD(TestSolutionStore_Rescan)
+    {
+        TemporaryDirectory directory("woipv-solution-store-rescan");
+        SolutionStore::Key key = {1, 2};
+        SolutionStore rescanning(directory.path, std::chrono::milliseconds(0));
+        SolutionStore waiting(directory.path, std::chrono::hours(1));
+
+        SolutionStore(directory.path).Insert(key, {SolvingResult::Unsatisfiable, "Test", {}});
+
+        // a miss only reads the other segments once per interval
+        Assert::AreEqual<size_t>(1, rescanning.Find(key).size());
+        Assert::AreEqual<size_t>(0, waiting.Find(key).size());
+    }
+
+    TEST_METHOD(TestSolutionStore_Compact)
+    {
+        TemporaryDirectory directory("woipv-solution-store-compact");
+        SolutionStore::Key first = {1, 2};
+        SolutionStore::Key second = {3, 4};
+        {
+            // two processes that both solved the second problem
+            SolutionStore one(directory.path);
+            SolutionStore other(directory.path);
+            one.Insert(first, {SolvingResult::Unsatisfiable, "Test", {}});
+            one.Insert(second, {SolvingResult::Unsatisfiable, "Test", {}});
+            other.Insert(second, {SolvingResult::Unsatisfiable, "Test", {}});
+        }
+
+        // number and total size of the segments
+        auto getSegments = [&directory]() {
+            std::pair<size_t, uintmax_t> segments;
+            for (const auto& file : std::filesystem::directory_iterator(directory.path)) {
+                if (file.path().extension() == ".segment") {
+                    segments.first++;
+                    segments.second += std::filesystem::file_size(file.path());
+                }
+            }
+            return segments;
+        };
+        auto before = getSegments();
+        Assert::AreEqual<size_t>(2, before.first);
+
+        // segments of finished processes
+        for (const auto& file : std::filesystem::directory_iterator(directory.path)) {
+            std::filesystem::last_write_time(file.path(), std::filesystem::file_time_type::clock::now() - std::chrono::hours(1));
+        }
+
+        SolutionStore store(directory.path);
+        auto after = getSegments();
+        Assert::AreEqual<size_t>(1, after.first);
+        Assert::IsTrue(after.second < before.second);
+        Assert::AreEqual<size_t>(1, store.Find(first).size());
+        Assert::AreEqual<size_t>(1, store.Find(second).size());
+        Assert::AreEqual<size_t>(1, SolutionStore(directory.path).Find(second).size());
+    }
+
+    TEST_METHOD(TestCachingSolver_Canonicalize)
+    {
+        Problem p(3, {{3, 1, 1}, {2}, {1, 3}});
+
+        auto canonical = CachingSolver::Canonicalize(p);
+
+        Assert::AreEqual<size_t>(2, canonical.GetClauses().size());
+        Assert::IsTrue(canonical.GetClauses()[0] == Clause{1, 3});
+        Assert::IsTrue(CachingSolver::GetKey(canonical) == CachingSolver::GetKey(CachingSolver::Canonicalize(Problem(3, {{1, 3}, {2}}))));
+        Assert::IsFalse(CachingSolver::GetKey(canonical) == CachingSolver::GetKey(CachingSolver::Canonicalize(Problem(3, {{1, 3}, {-2}}))));
+    }
+};
+}
@@ -0,0 +1,56 @@
+#include "CoreTest/stdafx.h"
+#include "CppUnitTest.h"
+
+#include "Core/Utility/CompactedProblem.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace CoreTest {
+TEST_CLASS(CompactedProblemTest)
+{
+public:
+
+    TEST_METHOD(TestCompactedProblem_Renumbers)
+    {
+        Problem p(1000, {{7, -500}, {-7, 1000}, {500}});
+
+        CompactedProblem compacted(p);
+
+        Assert::AreEqual<Variable>(3, compacted.GetProblem().GetNumberOfVariables());
+        Assert::IsTrue(std::vector<Clause>{{1, -2}, {-1, 3}, {2}} == compacted.GetProblem().GetClauses());
+        Assert::AreEqual<Variable>(500, compacted.GetOriginalVariable(2));
+        Assert::AreEqual<Variable>(1000, compacted.GetOriginalNumberOfVariables());
+    }
+
+    TEST_METHOD(TestCompactedProblem_Expand)
+    {
+        Problem p(1000, {{7, -500}, {-7, 1000}, {500}});
+        CompactedProblem compacted(p);
+        Assignment local(3);
+        local.SetState(1, VariableState::True);
+        local.SetState(2, VariableState::True);
+        local.SetState(3, VariableState::True);
+
+        auto assignment = compacted.Expand(local);
+
+        Assert::AreEqual<Variable>(1000, assignment.GetNumberOfVariables());
+        Assert::IsTrue(assignment.GetState(7) == VariableState::True);
+        Assert::IsTrue(assignment.GetState(500) == VariableState::True);
+        Assert::IsTrue(assignment.GetState(1000) == VariableState::True);
+        // unused
+        Assert::IsTrue(assignment.GetState(1) == VariableState::False);
+        Assert::IsTrue(p.Apply(assignment) == SolvingResult::Satisfiable);
+    }
+
+    TEST_METHOD(TestCompactedProblem_DenseIsUnchanged)
+    {
+        Problem p(3, {{1, -2}, {3}});
+
+        CompactedProblem compacted(p);
+
+        Assert::IsTrue(&p == &compacted.GetProblem());
+        Assert::AreEqual<Variable>(2, compacted.GetOriginalVariable(2));
+    }
+
+};
+}
@@ -0,0 +1,58 @@
+#include "CoreTest/stdafx.h"
+#include "CppUnitTest.h"
+
+#include "Core/Utility/ConnectedComponents.h"
+#include "Core/Utility/InstanceGenerator.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace CoreTest {
+TEST_CLASS(ConnectedComponentsTest)
+{
+public:
+
+    TEST_METHOD(TestFindConnectedComponents_Simple)
+    {
+        // 4 is unused
+        Problem p(7, {{1, -3}, {5, -6}, {2, 7}, {-3, 2}, {6}});
+
+        auto components = FindConnectedComponents(p);
+
+        Assert::AreEqual<size_t>(2, components.size());
+        Assert::IsTrue(std::vector<Variable>{1, 2, 3, 7} == components[0].variables);
+        Assert::IsTrue(std::vector<size_t>{0, 2, 3} == components[0].clauses);
+        Assert::IsTrue(std::vector<Variable>{5, 6} == components[1].variables);
+        Assert::IsTrue(std::vector<size_t>{1, 4} == components[1].clauses);
+    }
+
+    TEST_METHOD(TestFindConnectedComponents_Empty)
+    {
+        Problem p;
+
+        auto components = FindConnectedComponents(p);
+
+        Assert::AreEqual<size_t>(0, components.size());
+    }
+
+    TEST_METHOD(TestFindConnectedComponentsParallel_SameAsSequential)
+    {
+        GeneratorSettings settings;
+        settings.type = InstanceType::DisjointUnion;
+        settings.numberOfVariables = 100000;
+        settings.numberOfComponents = 1000;
+        settings.ratio = 3.0;
+        auto p = GenerateProblem(settings);
+
+        auto sequential = FindConnectedComponents(p);
+        auto parallel = FindConnectedComponentsParallel(p, 4);
+
+        Assert::AreEqual<size_t>(1000, sequential.size());
+        Assert::AreEqual(sequential.size(), parallel.size());
+        for (size_t i = 0; i < sequential.size(); i++) {
+            Assert::IsTrue(sequential[i].variables == parallel[i].variables);
+            Assert::IsTrue(sequential[i].clauses == parallel[i].clauses);
+        }
+    }
+
+};
+}
@@ -0,0 +1,86 @@
+#include "CoreTest/stdafx.h"
+#include "CppUnitTest.h"
+
+#include <cmath>
+#include <sstream>
+
+#include "Core/Utility/BenchmarkReader.h"
+#include "Core/Utility/CostModel.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace CoreTest {
+TEST_CLASS(CostModelTest)
+{
+public:
+
+    TEST_METHOD(TestCostModel_Calibrate)
+    {
+        // time = clauses^2 / 100, the undef row and the repeated header are ignored
+        std::stringstream csv;
+        csv << "time;problem;instance name;clauses;variables;used variables;density(C / V);avg clause length;CryptoMiniSat;CryptoMiniSat time;valid;" << std::endl;
+        csv << "t;a;a;100;50;50;2;3;sat;100;0;" << std::endl;
+        csv << "t;b;b;200;50;50;4;3;unsat;400;0;" << std::endl;
+        csv << "t;c;c;400;100;100;4;3;sat;1600;0;" << std::endl;
+        csv << "time;problem;instance name;clauses;variables;used variables;density(C / V);avg clause length;CryptoMiniSat;CryptoMiniSat time;valid;" << std::endl;
+        csv << "t;d;d;800;100;100;8;3;unsat;6400;0;" << std::endl;
+        csv << "t;e;e;1000;200;200;5;3;undef;10;0;" << std::endl;
+
+        auto model = CostModel::Calibrate(csv, "CryptoMiniSat", 1);
+
+        CostFeatures features;
+        features.clauses = 300;
+        features.variables = 75;
+        features.averageClauseLength = 3;
+        Assert::AreEqual(900.0, model.PredictSolveTime(features), 100.0);
+    }
+
+    TEST_METHOD(TestCostModel_NotEnoughResults)
+    {
+        std::stringstream csv;
+        csv << "time;problem;instance name;clauses;variables;used variables;density(C / V);avg clause length;CryptoMiniSat;CryptoMiniSat time;valid;" << std::endl;
+        csv << "t;a;a;100;50;50;2;3;sat;100;0;" << std::endl;
+
+        Assert::ExpectException<std::runtime_error>([&csv]() {
+            CostModel::Calibrate(csv, "CryptoMiniSat");
+        });
+    }
+
+    TEST_METHOD(TestCostModel_ReadFeatures)
+    {
+        // 1000 variables are declared, 4 are used
+        Problem problem(1000, {{1, 2}, {-1, 2}, {3, 4}, {-3, 4}});
+        std::stringstream csv;
+        csv << "time;problem;instance name;clauses;variables;used variables;density(C / V);avg clause length;valid;" << std::endl;
+        csv << "t;a;a;4;1000;4;0.004;2;1;" << std::endl;
+        csv << "time;problem;instance name;clauses;variables;density(C / V);avg clause length;valid;" << std::endl;
+        csv << "t;a;a;4;1000;0.004;2;1;" << std::endl;
+
+        BenchmarkReader reader(csv);
+        Assert::IsTrue(reader.Next());
+        auto features = CostModel::ReadFeatures(reader);
+        auto expected = CostModel::GetFeatures(problem);
+        Assert::IsTrue(features.has_value());
+        Assert::AreEqual(expected.clauses, features->clauses);
+        Assert::AreEqual(expected.variables, features->variables);
+        Assert::AreEqual(expected.averageClauseLength, features->averageClauseLength);
+
+        // older runs only have the declared number
+        Assert::IsTrue(reader.Next());
+        Assert::IsFalse(CostModel::ReadFeatures(reader).has_value());
+    }
+
+    TEST_METHOD(TestCostModel_Partitioned)
+    {
+        // quadratic: two halves are cheaper, unless each half is solved for many cut assignments
+        CostModel model({0, 2, 0, 0}, 1);
+        auto whole = CostModel::GetFeatures(Problem(4, {{1, 2}, {-1, 2}, {3, 4}, {-3, 4}}));
+        auto half = CostModel::GetFeatures(std::vector<Clause>{{1, 2}, {-1, 2}});
+
+        Assert::AreEqual<size_t>(4, whole.variables);
+        Assert::AreEqual(2.0, whole.averageClauseLength);
+        Assert::IsTrue(model.IsPartitioningCheaper(whole, {{half, 1}, {half, 1}}));
+        Assert::IsFalse(model.IsPartitioningCheaper(whole, {{half, 4}, {half, 4}}));
+    }
+};
+}
@@ -0,0 +1,79 @@
+#include "CoreTest/stdafx.h"
+#include "CppUnitTest.h"
+
+#include <sstream>
+
+#include "Core/Utility/InstanceGenerator.h"
+#include "Core/Utility/CNFParser.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace CoreTest {
+TEST_CLASS(InstanceGeneratorTest)
+{
+public:
+
+    TEST_METHOD(TestGenerate_Reproducible)
+    {
+        GeneratorSettings settings;
+        settings.numberOfVariables = 50;
+        settings.seed = 42;
+
+        auto p1 = GenerateProblem(settings);
+        auto p2 = GenerateProblem(settings);
+        settings.seed = 43;
+        auto p3 = GenerateProblem(settings);
+
+        Assert::AreEqual(p1.GetClauses(), p2.GetClauses());
+        Assert::IsFalse(p1.GetClauses() == p3.GetClauses());
+        Assert::AreEqual<size_t>(213, p1.GetClauses().size());
+    }
+
+    TEST_METHOD(TestGenerate_Planted)
+    {
+        GeneratorSettings settings;
+        settings.numberOfVariables = 100;
+        settings.ratio = 6.0;
+        settings.planted = true;
+
+        auto p = GenerateProblem(settings);
+
+        Assert::IsTrue(SolvingResult::Satisfiable == p.Apply(GetPlantedAssignment(settings)));
+    }
+
+    TEST_METHOD(TestGenerate_DisjointUnion)
+    {
+        GeneratorSettings settings;
+        settings.type = InstanceType::DisjointUnion;
+        settings.numberOfVariables = 40;
+        settings.numberOfComponents = 4;
+
+        auto p = GenerateProblem(settings);
+
+        // every clause stays within its range of 10 variables
+        for (const auto& clause : p.GetClauses()) {
+            auto component = (ToVariable(clause[0]) - 1) / 10;
+            for (const auto& literal : clause) {
+                Assert::AreEqual(component, (ToVariable(literal) - 1) / 10);
+            }
+        }
+    }
+
+    TEST_METHOD(TestWriteGeneratedCNF_MatchesProblem)
+    {
+        GeneratorSettings settings;
+        settings.type = InstanceType::Star;
+        settings.numberOfVariables = 60;
+        settings.numberOfComponents = 5;
+        std::stringstream ss;
+
+        WriteGeneratedCNF(settings, ss);
+        auto p = ParseCNF(ss);
+
+        Assert::AreEqual(GenerateProblem(settings).GetClauses(), p.GetClauses());
+        Assert::AreEqual(GetNumberOfClauses(settings), p.GetClauses().size());
+        Assert::AreEqual(60, p.GetNumberOfVariables());
+    }
+
+};
+}
@@ -0,0 +1,51 @@
+#include "CoreTest/stdafx.h"
+#include "CppUnitTest.h"
+
+#include "Core/Utility/RestrictionEngine.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace CoreTest {
+TEST_CLASS(RestrictionEngineTest)
+{
+public:
+
+    TEST_METHOD(TestRestrictionEngine_Simplify)
+    {
+        RestrictionEngine engine({{1, 2, 3}, {-1, 2, 3}, {4, 5}});
+        Assignment assignment(5);
+        assignment.SetState(1, VariableState::True);
+
+        auto result = engine.Restrict(assignment);
+
+        Assert::IsFalse(result.conflict);
+        Assert::IsTrue(result.implied.empty());
+        Assert::IsTrue(std::vector<Clause>{{2, 3}, {4, 5}} == result.clauses);
+    }
+
+    TEST_METHOD(TestRestrictionEngine_Propagate)
+    {
+        RestrictionEngine engine({{-1, 2}, {-2, 3}, {-3, -4, 5}, {4, 6, 7}});
+        Assignment assignment(7);
+        assignment.SetState(1, VariableState::True);
+        assignment.SetState(5, VariableState::False);
+
+        auto result = engine.Restrict(assignment);
+
+        Assert::IsFalse(result.conflict);
+        Assert::IsTrue(std::vector<Literal>{2, 3, -4} == result.implied);
+        Assert::IsTrue(std::vector<Clause>{{6, 7}} == result.clauses);
+    }
+
+    TEST_METHOD(TestRestrictionEngine_Conflict)
+    {
+        RestrictionEngine engine({{-1, 2}, {-1, -2}, {3, 4}});
+        Assignment assignment(4);
+        assignment.SetState(1, VariableState::True);
+
+        Assert::IsTrue(engine.Restrict(assignment).conflict);
+        Assert::IsFalse(engine.Restrict(Assignment(4)).conflict);
+    }
+
+};
+}
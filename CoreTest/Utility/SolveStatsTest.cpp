@@ -0,0 +1,90 @@
+#include "CoreTest/stdafx.h"
+#include "CppUnitTest.h"
+
+#include "Core/Utility/BitSlicedSolver.h"
+#include "Core/Utility/StatsCollector.h"
+#include "Core/Utility/TaskScheduler.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace CoreTest {
+/// <summary>
+/// solves every clause as a subproblem in its own task, like a partitioner
+/// </summary>
+class SplittingSolver : public SATSolver {
+public:
+    virtual Solution Solve(const Problem& problem, OptionalTimeLimitMs timeLimit) override
+    {
+        TaskGroup group;
+        for (const auto& clause : problem.GetClauses()) {
+            group.Run([&problem, &clause, timeLimit]() {
+                StatsCollector::AddSubproblems(1);
+                StatsCollector::AddConflicts(clause.size());
+                BitSlicedSolver().Solve(Problem(problem.GetNumberOfVariables(), {clause}), timeLimit);
+            });
+        }
+        group.Wait();
+        StatsCollector::AddCutSize(1);
+        return BitSlicedSolver().Solve(problem, timeLimit);
+    }
+};
+
+/// <summary>
+/// measures a nested solve
+/// </summary>
+class NestingSolver : public SATSolver {
+public:
+    SolveStats nested;
+
+    virtual Solution Solve(const Problem& problem, OptionalTimeLimitMs timeLimit) override
+    {
+        StatsCollector::AddCacheHits(1);
+        auto [solution, stats] = SplittingSolver().SolveWithStats(problem, timeLimit);
+        nested = stats;
+        return solution;
+    }
+};
+
+TEST_CLASS(SolveStatsTest)
+{
+public:
+
+    TEST_METHOD(TestSolveStats_Tasks)
+    {
+        Problem p(3, {{1, 2}, {-1, 3}, {-2, -3, 1}});
+
+        auto [solution, stats] = SplittingSolver().SolveWithStats(p, {});
+
+        Assert::IsTrue(solution.first == SolvingResult::Satisfiable);
+        Assert::AreEqual<size_t>(3, stats.subproblems);
+        Assert::AreEqual<size_t>(7, stats.conflicts);
+        Assert::AreEqual<size_t>(1, stats.cutSize);
+        Assert::IsTrue(stats.peakMemory > 0);
+    }
+
+    TEST_METHOD(TestSolveStats_Nested)
+    {
+        Problem p(2, {{1, 2}, {-1, -2}});
+        NestingSolver solver;
+
+        auto [solution, stats] = solver.SolveWithStats(p, {});
+
+        // the counters of the nested solve are added to the enclosing one
+        Assert::IsTrue(solution.first == SolvingResult::Satisfiable);
+        Assert::AreEqual<size_t>(2, solver.nested.subproblems);
+        Assert::AreEqual<size_t>(0, solver.nested.cacheHits);
+        Assert::AreEqual<size_t>(2, stats.subproblems);
+        Assert::AreEqual<size_t>(1, stats.cacheHits);
+    }
+
+    TEST_METHOD(TestSolveStats_NotCollected)
+    {
+        // reporting outside of a measured solve is ignored
+        StatsCollector::AddSubproblems(1);
+        Assert::IsFalse(static_cast<bool>(StatsCollector::GetCurrent()));
+
+        auto [solution, stats] = SplittingSolver().SolveWithStats(Problem(1, {{1}}), {});
+        Assert::AreEqual<size_t>(1, stats.subproblems);
+    }
+};
+}
@@ -0,0 +1,121 @@
+#include "CoreTest/stdafx.h"
+#include "CppUnitTest.h"
+
+#include <sstream>
+
+#include "Core/Utility/SolverSelector.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace CoreTest {
+static std::string CreateBenchmark()
+{
+    // B is fast on small instances and fails on large ones, A solves everything slowly
+    std::stringstream csv;
+    csv << "time;problem;instance name;clauses;variables;used variables;density(C / V);avg clause length;A;A time;B;B time;valid;" << std::endl;
+    csv << "t;s1;s1;100;50;50;2;3;sat;400;sat;10;1;" << std::endl;
+    csv << "t;s2;s2;120;60;60;2;3;unsat;500;unsat;20;1;" << std::endl;
+    csv << "t;s3;s3;110;55;55;2;3;sat;450;sat;30;1;" << std::endl;
+    csv << "t;l1;l1;100000;50000;50000;2;3;sat;9000;undef;100000;1;" << std::endl;
+    csv << "t;l2;l2;120000;60000;60000;2;3;unsat;8000;undef;100000;1;" << std::endl;
+    csv << "t;l3;l3;110000;55000;55000;2;3;sat;7000;undef;100000;1;" << std::endl;
+    return csv.str();
+}
+
+TEST_CLASS(SolverSelectorTest)
+{
+public:
+
+    TEST_METHOD(TestSolverSelector_Select)
+    {
+        std::stringstream csv(CreateBenchmark());
+        auto selector = SolverSelector::Train(csv, {"A", "B"}, 3);
+        Assert::AreEqual<size_t>(6, selector.GetNumberOfSamples());
+
+        CostFeatures small;
+        small.clauses = 105;
+        small.variables = 52;
+        small.averageClauseLength = 3;
+        auto schedule = selector.Select(small, std::chrono::milliseconds(100000));
+        Assert::AreEqual<size_t>(1, schedule.size());
+        Assert::AreEqual(std::string("B"), schedule[0].solver);
+
+        CostFeatures large;
+        large.clauses = 105000;
+        large.variables = 52000;
+        large.averageClauseLength = 3;
+        schedule = selector.Select(large, std::chrono::milliseconds(100000));
+        Assert::AreEqual<size_t>(1, schedule.size());
+        Assert::AreEqual(std::string("A"), schedule[0].solver);
+    }
+
+    TEST_METHOD(TestSolverSelector_EarlierStep)
+    {
+        // all neighbours: B solves two of three quickly, A solves all three slowly
+        std::stringstream csv;
+        csv << "time;problem;instance name;clauses;variables;used variables;density(C / V);avg clause length;A;A time;B;B time;valid;" << std::endl;
+        csv << "t;a;a;100;50;50;2;3;sat;40000;sat;100;1;" << std::endl;
+        csv << "t;b;b;100;50;50;2;3;sat;50000;sat;3000;1;" << std::endl;
+        csv << "t;c;c;100;50;50;2;3;sat;60000;undef;100000;1;" << std::endl;
+        auto selector = SolverSelector::Train(csv, {"A", "B"}, 3);
+
+        CostFeatures features;
+        features.clauses = 100;
+        features.variables = 50;
+        features.averageClauseLength = 3;
+        auto schedule = selector.Select(features, std::chrono::milliseconds(100000));
+
+        Assert::AreEqual<size_t>(2, schedule.size());
+        Assert::AreEqual(std::string("B"), schedule[0].solver);
+        Assert::IsTrue(schedule[0].timeLimit == std::chrono::milliseconds(6000));
+        Assert::AreEqual(std::string("A"), schedule[1].solver);
+        Assert::IsFalse(schedule[1].timeLimit.has_value());
+
+        // half of the time at most
+        schedule = selector.Select(features, std::chrono::milliseconds(8000));
+        Assert::IsTrue(schedule[0].timeLimit == std::chrono::milliseconds(4000));
+    }
+
+    TEST_METHOD(TestSolverSelector_SaveLoad)
+    {
+        std::stringstream csv(CreateBenchmark());
+        auto selector = SolverSelector::Train(csv, {"A", "B"}, 3);
+
+        std::stringstream model;
+        selector.Save(model);
+        auto loaded = SolverSelector::Load(model);
+
+        Assert::AreEqual<size_t>(6, loaded.GetNumberOfSamples());
+        Assert::IsTrue(selector.GetSolvers() == loaded.GetSolvers());
+        CostFeatures small;
+        small.clauses = 105;
+        small.variables = 52;
+        small.averageClauseLength = 3;
+        Assert::AreEqual(std::string("B"), loaded.Select(small, {})[0].solver);
+    }
+
+    TEST_METHOD(TestSolverSelector_OldModel)
+    {
+        // samples with the declared number of variables
+        std::stringstream model;
+        model << "k;3" << std::endl;
+        model << "solvers;A;B" << std::endl;
+        model << "100;50;3;400;10" << std::endl;
+
+        Assert::ExpectException<std::runtime_error>([&model]() {
+            SolverSelector::Load(model);
+        });
+    }
+
+    TEST_METHOD(TestSolverSelector_NoResults)
+    {
+        std::stringstream csv;
+        csv << "time;problem;instance name;clauses;variables;used variables;density(C / V);avg clause length;A;A time;valid;" << std::endl;
+        csv << "t;a;a;100;50;50;2;3;undef;100000;1;" << std::endl;
+
+        Assert::ExpectException<std::runtime_error>([&csv]() {
+            SolverSelector::Train(csv, {"A"});
+        });
+    }
+};
+}
@@ -0,0 +1,78 @@
+#include "CoreTest/stdafx.h"
+#include "CppUnitTest.h"
+
+#include <limits>
+
+#include "Core/Utility/TimeBudget.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace std::chrono_literals;
+
+namespace CoreTest {
+TEST_CLASS(TimeBudgetTest)
+{
+public:
+
+    TEST_METHOD(TestTimeBudget_NoLimit)
+    {
+        TimeBudget budget({}, std::chrono::steady_clock::now(), {1, 2});
+
+        Assert::IsFalse(budget.Start(0).has_value());
+        Assert::IsFalse(budget.Start(1).has_value());
+    }
+
+    TEST_METHOD(TestTimeBudget_Proportional)
+    {
+        TimeBudget budget(10000ms, std::chrono::steady_clock::now(), {1, 3}, 1, 0ms);
+
+        auto first = budget.Start(0).value();
+        Assert::IsTrue(first > 2000ms && first <= 2500ms);
+        budget.Finish(0);
+
+        // the last job gets the rest, the unused time of the first one included
+        auto last = budget.Start(1).value();
+        Assert::IsTrue(last > 9000ms && last <= 10000ms);
+    }
+
+    TEST_METHOD(TestTimeBudget_Parallel)
+    {
+        TimeBudget budget(10000ms, std::chrono::steady_clock::now(), {1, 1, 2}, 2, 0ms);
+
+        // two jobs run at once, but no share exceeds the deadline
+        auto first = budget.Start(0).value();
+        Assert::IsTrue(first > 4000ms && first <= 5000ms);
+        auto second = budget.Start(1).value();
+        Assert::IsTrue(second > 4000ms && second <= 5000ms);
+        auto last = budget.Start(2).value();
+        Assert::IsTrue(last <= 10000ms);
+    }
+
+    TEST_METHOD(TestTimeBudget_MinimumShare)
+    {
+        TimeBudget budget(500ms, std::chrono::steady_clock::now(), {1, 100}, 1, 200ms);
+        Assert::IsTrue(budget.Start(0).value() >= 190ms);
+
+        TimeBudget expired(100ms, std::chrono::steady_clock::now() - 1s, {1});
+        Assert::IsTrue(expired.Start(0).value() == 0ms);
+    }
+
+    TEST_METHOD(TestTimeBudget_Invalid)
+    {
+        Assert::ExpectException<std::invalid_argument>([]() {
+            TimeBudget budget(1000ms, std::chrono::steady_clock::now(), {1, 0});
+        });
+        Assert::ExpectException<std::invalid_argument>([]() {
+            TimeBudget budget(1000ms, std::chrono::steady_clock::now(), {1, std::numeric_limits<double>::infinity()});
+        });
+
+        TimeBudget budget(1000ms, std::chrono::steady_clock::now(), {1});
+        budget.Start(0);
+        Assert::ExpectException<std::invalid_argument>([&budget]() {
+            budget.Start(0);
+        });
+        Assert::ExpectException<std::invalid_argument>([&budget]() {
+            budget.Start(1);
+        });
+    }
+};
+}
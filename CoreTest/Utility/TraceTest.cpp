@@ -0,0 +1,51 @@
+#include "CoreTest/stdafx.h"
+#include "CppUnitTest.h"
+
+#include <sstream>
+
+#include "Core/Utility/Trace.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace CoreTest {
+TEST_CLASS(TraceTest)
+{
+public:
+
+    TEST_METHOD(TestTrace_Disabled)
+    {
+        Tracer::Disable();
+        Tracer::Clear();
+        {
+            TraceSpan span("Disabled", "test");
+        }
+
+        std::stringstream output;
+        Tracer::WriteChromeTrace(output);
+        Assert::IsTrue(output.str().find("Disabled") == std::string::npos);
+    }
+
+    TEST_METHOD(TestTrace_Span)
+    {
+        Tracer::Clear();
+        Tracer::Enable();
+        {
+            TraceSpan outer("Outer", "test");
+            TraceSpan inner("Inner \"quoted\"", "test");
+            inner.End();
+        }
+        Tracer::Disable();
+
+        std::stringstream output;
+        Tracer::WriteChromeTrace(output);
+        auto trace = output.str();
+        Tracer::Clear();
+
+        Assert::IsTrue(trace.find("\"traceEvents\":[") != std::string::npos);
+        Assert::IsTrue(trace.find("{\"name\":\"Outer\",\"cat\":\"test\",\"ph\":\"X\"") != std::string::npos);
+        Assert::IsTrue(trace.find("\"Inner \\\"quoted\\\"\"") != std::string::npos);
+        // the inner span ended first
+        Assert::IsTrue(trace.find("Inner") < trace.find("Outer"));
+    }
+};
+}
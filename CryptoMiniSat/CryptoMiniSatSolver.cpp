@@ -11,14 +11,19 @@
 #include <sstream>
 
 # include "Core/Utility/CNFWriter.h"
+# include "Core/Utility/CompactedProblem.h"
+# include "Core/Utility/StatsCollector.h"
+# include "Core/Utility/Trace.h"
 
 // Todo: move exe to a more robust location
 const std::string ExeName = "..\\CryptoMiniSat\\cryptominisat5-win-amd64.exe";
-const std::string DefaultOptions = "--verb 0";
+// verbosity 1 prints the statistics (comment lines), needed for the number of conflicts
+const std::string DefaultOptions = "--verb 1";
 const std::string TimeLimitOption = "--maxtime";
 
 std::string exec(const std::string cmd)
 {
+    TraceSpan span("cryptominisat5 process", "process");
     const size_t BufferSize = 128;
     static_assert(BufferSize < std::numeric_limits<int>::max(), "BufferSize will be casted to int as fgets only accepts int");
     std::array<char, BufferSize> buffer;
@@ -87,6 +92,44 @@ SolvingResult ParseSolvingResult(std::string line)
     throw std::runtime_error("unknown result");
 }
 
+std::string RemoveComments(const std::string& output)
+{
+    std::stringstream ss(output);
+    std::string ret;
+    std::string line;
+    while (std::getline(ss, line)) {
+        if (line.rfind("c", 0) != 0) {
+            ret += line + "\n";
+        }
+    }
+    return ret;
+}
+
+size_t ParseConflicts(const std::string& output)
+{
+    // example
+    //c conflicts                : 3542      (3866.81   /sec)
+    constexpr auto conflicts = "c conflicts";
+
+    std::stringstream ss(output);
+    std::string line;
+    while (std::getline(ss, line)) {
+        if (line.rfind(conflicts, 0) != 0) {
+            continue;
+        }
+        auto separator = line.find(':');
+        if (separator == std::string::npos) {
+            continue;
+        }
+        std::stringstream value(line.substr(separator + 1));
+        size_t count;
+        if (value >> count) {
+            return count;
+        }
+    }
+    return 0;
+}
+
 std::pair<SolvingResult, std::optional<Assignment>> ParseResult(std::string result, Variable numberOfVariables)
 {
     // examples
@@ -131,7 +174,15 @@ std::pair<SolvingResult, std::optional<Assignment>> ParseResult(std::string resu
 
 std::pair<SolvingResult, std::optional<Assignment>> CryptoMiniSatSolver::Solve(const Problem& problem, OptionalTimeLimitMs timeLimit)
 {
+    TraceSpan span("CryptoMiniSat", "solver");
     auto start = std::chrono::steady_clock::now();
+    if (timeLimit && timeLimit.value() <= std::chrono::milliseconds(0)) {
+        // the minimal time limit of the process would exceed the deadline of the caller
+        return {SolvingResult::Undefined, {}};
+    }
+
+    // only pass the used variables, this keeps the file and the v-lines small
+    CompactedProblem compacted(problem);
 
     auto input = getUniqueFilename();
     {
@@ -139,7 +190,7 @@ std::pair<SolvingResult, std::optional<Assignment>> CryptoMiniSatSolver::Solve(c
         if (!tempFile) {
             throw std::runtime_error("could not create temporary cnf-file");
         }
-        WriteCNF(problem, tempFile);
+        WriteCNF(compacted.GetProblem(), tempFile);
     }
 
     // RAII for file deletion
@@ -149,6 +200,10 @@ std::pair<SolvingResult, std::optional<Assignment>> CryptoMiniSatSolver::Solve(c
     };
     std::unique_ptr<std::string, decltype(fileDeleter)> inputCleanup(new std::string(input), fileDeleter);
 
-    auto result = exec(CreateExecCommand(input, GetRemaining(timeLimit, start)));
-    return ParseResult(result, problem.GetNumberOfVariables());
+    auto processStart = std::chrono::steady_clock::now();
+    auto output = exec(CreateExecCommand(input, GetRemaining(timeLimit, start)));
+    StatsCollector::AddProcessTime(std::chrono::duration_cast<std::chrono::milliseconds>(GetElapsed(processStart)));
+    StatsCollector::AddConflicts(ParseConflicts(output));
+
+    return compacted.Expand(ParseResult(RemoveComments(output), compacted.GetProblem().GetNumberOfVariables()));
 }
@@ -2,6 +2,8 @@
 #include "GurobiSolver.h"
 
 #include "Gurobi/gurobi_c++.h"
+#include "Core/Utility/CompactedProblem.h"
+#include "Core/Utility/Trace.h"
 
 // defines to get rid of the IntelliSense errors
 #pragma region backup gurobi defines
@@ -46,11 +48,16 @@ Assignment CreateAssignment(const std::vector<GRBVar>& variables)
     return assignment;
 }
 
-std::pair<SolvingResult, std::optional<Assignment>> GurobiSolver::Solve(const Problem & problem, OptionalTimeLimitMs timeLimit)
+std::pair<SolvingResult, std::optional<Assignment>> GurobiSolver::Solve(const Problem & originalProblem, OptionalTimeLimitMs timeLimit)
 {
+    TraceSpan span("Gurobi", "solver");
     try {
         auto start = std::chrono::steady_clock::now();
 
+        // only model the used variables
+        CompactedProblem compacted(originalProblem);
+        const auto& problem = compacted.GetProblem();
+
         // create an environment
         GRBEnv env = GRBEnv(true);
         if (!ENABLE_CONSOLE_LOGGING) {
@@ -101,7 +108,7 @@ std::pair<SolvingResult, std::optional<Assignment>> GurobiSolver::Solve(const Pr
         // return result
         auto status = model.get(GRB_IntAttr_Status);
         if (status == GRB_OPTIMAL) {
-            return {SolvingResult::Satisfiable, CreateAssignment(variables)};
+            return {SolvingResult::Satisfiable, compacted.Expand(CreateAssignment(variables))};
         } else if (status == GRB_INFEASIBLE) {
             return {SolvingResult::Unsatisfiable, {}};
         } else if (status == GRB_TIME_LIMIT) {
@@ -4,6 +4,8 @@
 #include <iostream>
 
 #include "LocalSolver/localsolver.h"
+#include "Core/Utility/CompactedProblem.h"
+#include "Core/Utility/Trace.h"
 
 using namespace localsolver;
 
@@ -32,10 +34,15 @@ Assignment CreateAssignment(const std::vector<localsolver::LSExpression>& variab
     return assignment;
 }
 
-std::pair<SolvingResult, std::optional<Assignment>> LocalSolverSat::Solve(const Problem & problem, OptionalTimeLimitMs timeLimit)
+std::pair<SolvingResult, std::optional<Assignment>> LocalSolverSat::Solve(const Problem & originalProblem, OptionalTimeLimitMs timeLimit)
 {
+    TraceSpan span("LocalSolver", "solver");
     auto start = std::chrono::steady_clock::now();
 
+    // only model the used variables
+    CompactedProblem compacted(originalProblem);
+    const auto& problem = compacted.GetProblem();
+
     // Declares the optimization model.
     LocalSolver localsolver;
     auto model = localsolver.getModel();
@@ -99,7 +106,7 @@ std::pair<SolvingResult, std::optional<Assignment>> LocalSolverSat::Solve(const
             // not finished
             return {SolvingResult::Undefined, {}};
         case SS_Optimal:
-            return {SolvingResult::Satisfiable, CreateAssignment(variables)};
+            return {SolvingResult::Satisfiable, compacted.Expand(CreateAssignment(variables))};
     }
     throw std::runtime_error("unknown solution status");
 }
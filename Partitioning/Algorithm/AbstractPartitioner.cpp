@@ -2,12 +2,25 @@
 #include "AbstractPartitioner.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <functional>
 #include <map>
+#include <memory>
+#include <mutex>
 
 #include "TimeLimitError.h"
+#include "Core/Utility/BitSlicedSolver.h"
+#include "Core/Utility/StatsCollector.h"
+#include "Core/Utility/TaskScheduler.h"
+#include "Core/Utility/TimeBudget.h"
+#include "Core/Utility/Trace.h"
+#include "Partitioning/Utility/ClauseRouter.h"
+#include "Partitioning/Utility/PartitionCache.h"
 
 Solution AbstractPartitioner::Solve(const Problem& problem, OptionalTimeLimitMs optionalTimeLimit)
 {
+    TraceSpan span("Partitioner", "partitioning");
     start = std::chrono::steady_clock::now();
     timeLimit = optionalTimeLimit;
 
@@ -15,34 +28,96 @@ Solution AbstractPartitioner::Solve(const Problem& problem, OptionalTimeLimitMs
         throw std::runtime_error("missing partition solver");
     }
 
+    // the temporary data structures of the solve are released at once
+    arena = std::make_unique<SolveArena>();
+    Solution solution;
     try {
-        return SolveExt(problem, optionalTimeLimit);
+        solution = SolveExt(problem, optionalTimeLimit);
     } catch (TimeLimitError&) {
         // time limit exceeded
-        return {SolvingResult::Undefined, {}};
+        solution = {SolvingResult::Undefined, {}};
+    } catch (...) {
+        arena.reset();
+        throw;
     }
+    arena.reset();
+    return solution;
+}
+
+size_t AbstractPartitioner::GetCacheHits() const
+{
+    return cacheHits;
+}
+
+size_t AbstractPartitioner::GetCacheMisses() const
+{
+    return cacheMisses;
+}
+
+void AbstractPartitioner::SetRecursion(PartitionerFactory factory, size_t leafSize, size_t maxDepth, double levelShare)
+{
+    if (!factory) {
+        throw std::invalid_argument("missing partitioner factory");
+    }
+    if (levelShare <= 0 || levelShare > 1) {
+        throw std::invalid_argument("share of a level must be in (0, 1]");
+    }
+    recursion = Recursion{std::move(factory), leafSize, maxDepth, levelShare, 0};
+}
+
+void AbstractPartitioner::SetCostModel(std::shared_ptr<const CostModel> model)
+{
+    costModel = std::move(model);
+}
+
+void AbstractPartitioner::SetBitSlicedThreshold(Variable threshold)
+{
+    if (threshold < 0 || threshold > BitSlicedSolver::MaxVariables) {
+        throw std::invalid_argument("threshold exceeds the variables of the bit-sliced enumeration");
+    }
+    bitSlicedThreshold = threshold;
 }
 
 Solution AbstractPartitioner::SolveExt(const Problem& problem, OptionalTimeLimitMs optionalTimeLimit)
 {
+    TraceSpan createSpan("CreatePartitions", "partitioning");
     auto partitions = CreatePartitions(problem);
     RemoveEmptyPartitions(partitions);
+    createSpan.End();
     if (partitions.size() <= 1) {
         // no valid partitions
         return partitionSolver->Solve(problem, GetRemainingTimeLimit());
     }
+    TraceSpan cutSpan("FindCutSet", "partitioning");
     auto cutSet = FindCutSet(partitions);
+    auto order = OrderCutVariables(partitions, cutSet);
+    cutSpan.End();
+    TraceSpan routeSpan("RouteClauses", "partitioning");
+    auto clauses = RouteClauses(problem, partitions, cutSet, order);
+    routeSpan.End();
+    if (!clauses) {
+        // partitions don't cover the clauses
+        return partitionSolver->Solve(problem, GetRemainingTimeLimit());
+    }
 
-    // optimistic approach
-    auto assignment = CreateOptimisticAssignment(problem, cutSet);
-    auto result = TrySolve(problem, partitions, cutSet, assignment);
-    if (result.first == SolvingResult::Satisfiable) {
-        return result;
+    TraceSpan checkSpan("IsGoodPartitioning", "partitioning");
+    std::vector<Problem> problems;
+    for (const auto& partitionClauses : clauses.value()) {
+        CheckTimeLimit();
+        problems.emplace_back(problem.GetNumberOfVariables(), partitionClauses.ToClauses());
+    }
+    auto isGood = IsGoodPartitioning(problems, partitions, cutSet);
+    checkSpan.End();
+    if (!isGood) {
+        // partitions are bad
+        // solve original problem directly
+        return partitionSolver->Solve(problem, GetRemainingTimeLimit());
     }
+    problems.clear();
+    // the cut set contains both literals of a cut variable
+    StatsCollector::AddCutSize(cutSet.size() / 2);
 
-    // try solve recursivly
-    assignment = Assignment(problem.GetNumberOfVariables());
-    return TrySolve(problem, partitions, cutSet, assignment, FirstVariable);
+    return SolveCubes(problem, partitions, cutSet, order, clauses.value());
 }
 
 std::set<Literal> AbstractPartitioner::FindCutSet(const std::vector<std::set<Variable>>& partitions)
@@ -104,98 +179,404 @@ Assignment AbstractPartitioner::CreateOptimisticAssignment(const Problem& proble
     return assignment;
 }
 
-Solution AbstractPartitioner::TrySolve(const Problem& problem, const std::vector<std::set<Variable>>& partitions, const std::set<Variable>& cutSet, const Assignment& assignment)
+std::optional<std::vector<PartitionClauses>> AbstractPartitioner::RouteClauses(const Problem& problem, const std::vector<std::set<Variable>>& partitions, const std::set<Variable>& cutSet, const std::vector<Variable>& order)
 {
-    auto problems = CreateSubProblems(problem, partitions, assignment);
-    Solution result;
-    if (!IsGoodPartitioning(problems, partitions, cutSet)) {
-        // partitions are bad
-        // solve original problem directly
-        result = partitionSolver->Solve(problem, GetRemainingTimeLimit());
-    } else {
-        auto solutions = SolveInternal(problems);
-        result = Merge(problem, partitions, cutSet, assignment, solutions);
+    CheckTimeLimit();
+
+    // depth of the cube at which a partition can be solved
+    std::vector<size_t> position(static_cast<size_t>(problem.GetNumberOfVariables()) + 1, 0);
+    for (size_t i = 0; i < order.size(); i++) {
+        position[order[i]] = i + 1;
+    }
+    std::vector<size_t> completion(partitions.size(), 0);
+    for (size_t i = 0; i < partitions.size(); i++) {
+        for (auto variable : partitions[i]) {
+            completion[i] = std::max(completion[i], position[variable]);
+        }
     }
-    return result;
+
+    ClauseRouter router(problem.GetNumberOfVariables(), partitions, cutSet);
+    auto clauses = router.Route(problem, Assignment(problem.GetNumberOfVariables()), [&](const Clause& clause) {
+        // decided by the cube, check it as early as possible
+        auto target = ClauseRouter::None;
+        for (size_t j = 0; j < partitions.size(); j++) {
+            auto containsAll = std::all_of(clause.begin(), clause.end(), [&](auto literal) {
+                return partitions[j].find(ToVariable(literal)) != partitions[j].end();
+            });
+            if (containsAll && (target == ClauseRouter::None || completion[j] < completion[target])) {
+                target = j;
+            }
+        }
+        return target;
+    });
+
+    CheckTimeLimit();
+    return clauses;
 }
 
-Solution AbstractPartitioner::TrySolve(const Problem& problem, const std::vector<std::set<Variable>>& partitions, const std::set<Variable>& cutSet, Assignment& assignment, Variable depth)
+std::vector<Variable> AbstractPartitioner::OrderCutVariables(const std::vector<std::set<Variable>>& partitions, const std::set<Variable>& cutSet)
 {
-    CheckTimeLimit();
+    // open cut variables of each partition
+    std::vector<std::vector<Variable>> open(partitions.size());
+    for (size_t i = 0; i < partitions.size(); i++) {
+        for (auto variable : partitions[i]) {
+            if (cutSet.find(variable) != cutSet.end()) {
+                open[i].push_back(variable);
+            }
+        }
+    }
+
+    std::vector<Variable> order;
+    std::set<Variable> ordered;
+    while (true) {
+        CheckTimeLimit();
 
-    if (depth > problem.GetNumberOfVariables()) {
-        return TrySolve(problem, partitions, cutSet, assignment);
+        // partition with the fewest open cut variables
+        std::optional<size_t> next;
+        for (size_t i = 0; i < open.size(); i++) {
+            open[i].erase(std::remove_if(open[i].begin(), open[i].end(), [&ordered](auto variable) {
+                return ordered.find(variable) != ordered.end();
+            }), open[i].end());
+            if (!open[i].empty() && (!next || open[i].size() < open[next.value()].size())) {
+                next = i;
+            }
+        }
+        if (!next) {
+            break;
+        }
+        for (auto variable : open[next.value()]) {
+            order.push_back(variable);
+            ordered.insert(variable);
+        }
+    }
+    return order;
+}
+
+Solution AbstractPartitioner::SolveCubes(const Problem& problem, const std::vector<std::set<Variable>>& partitions, const std::set<Variable>& cutSet, const std::vector<Variable>& order, const std::vector<PartitionClauses>& clauses)
+{
+    TraceSpan span("SolveCubes", "solving");
+
+    // partitions that can be solved once the first depth variables of the order are assigned
+    std::vector<size_t> position(static_cast<size_t>(problem.GetNumberOfVariables()) + 1, 0);
+    for (size_t i = 0; i < order.size(); i++) {
+        position[order[i]] = i + 1;
+    }
+    std::vector<std::vector<size_t>> completed(order.size() + 1);
+    for (size_t i = 0; i < partitions.size(); i++) {
+        size_t depth = 0;
+        for (auto variable : partitions[i]) {
+            depth = std::max(depth, position[variable]);
+        }
+        completed[depth].push_back(i);
+    }
+
+    // cut variables of each partition, they determine the result of the partition
+    std::vector<std::vector<Variable>> cutVariables(partitions.size());
+    for (size_t i = 0; i < partitions.size(); i++) {
+        for (auto variable : partitions[i]) {
+            if (position[variable] > 0) {
+                cutVariables[i].push_back(variable);
+            }
+        }
     }
+    PartitionCache cache(partitions.size());
 
-    if (cutSet.find(depth) == cutSet.end()) {
-        // variable is not part of the cutSet
-        // -> don't assign
-        return TrySolve(problem, partitions, cutSet, assignment, depth + 1);
+    // occurrence lists are built once, every cube only restricts them
+    std::vector<RestrictionEngine> engines;
+    engines.reserve(clauses.size());
+    for (const auto& partitionClauses : clauses) {
+        CheckTimeLimit();
+        engines.emplace_back(partitionClauses.ToClauses());
     }
 
-    // try true
-    assignment.SetState(depth, VariableState::True);
-    auto result = TrySolve(problem, partitions, cutSet, assignment, depth + 1);
-    if (result.first == SolvingResult::Satisfiable) {
-        return result;
+    // value that is tried first for each cut variable
+    auto optimistic = CreateOptimisticAssignment(problem, cutSet);
+
+    std::mutex mutex;
+    std::optional<Assignment> satisfying;
+    bool undefined = false;
+    using Models = std::vector<std::shared_ptr<const Assignment>>;
+    struct Cube {
+        Assignment assignment;
+        size_t depth;
+        Models models;
+        /// <summary>
+        /// number of cut variables that differ from the optimistic value
+        /// </summary>
+        size_t discrepancies;
+    };
+
+    // only the first levels are handed to other workers (a few tasks per thread),
+    // deeper alternatives are kept on the stack of the worker, so memory stays linear in the depth
+    size_t splitDepth = 4;
+    for (auto threads = TaskScheduler::GetShared().GetNumberOfThreads(); threads > 1; threads /= 2) {
+        splitDepth++;
     }
 
-    // try false
-    assignment.SetState(depth, VariableState::False);
-    return TrySolve(problem, partitions, cutSet, assignment, depth + 1);
+    // Limited discrepancy search: a round only follows cubes that deviate from the optimistic values at most
+    // maxDiscrepancies times, so the cubes close to the optimistic assignment are tried first.
+    // The limit is raised until a round is not limited anymore, the cache keeps repeated partitions cheap.
+    size_t maxDiscrepancies = 0;
+    try {
+        while (true) {
+            std::atomic<bool> limited{false};
+            TaskGroup group;
+            std::function<void(Cube)> explore = [&](Cube first) {
+                std::vector<Cube> stack;
+                stack.push_back(std::move(first));
+                while (!stack.empty()) {
+                    CheckTimeLimit();
+                    if (group.IsCancelled()) {
+                        return;
+                    }
+                    auto cube = std::move(stack.back());
+                    stack.pop_back();
+
+                    // follows the optimistic values, the other values are left for later or to other workers
+                    auto pruned = false;
+                    while (!pruned) {
+                        CheckTimeLimit();
+                        if (group.IsCancelled()) {
+                            return;
+                        }
+
+                        for (auto partition : completed[cube.depth]) {
+                            PartitionCache::Restriction restriction;
+                            for (auto variable : cutVariables[partition]) {
+                                restriction.push_back(cube.assignment.GetState(variable) == VariableState::True);
+                            }
+                            auto model = cache.Find(partition, restriction);
+                            if (!model) {
+                                auto solution = SolvePartition(problem, engines[partition], cube.assignment);
+                                if (solution.first == SolvingResult::Undefined) {
+                                    std::lock_guard<std::mutex> lock(mutex);
+                                    undefined = true;
+                                    group.Cancel();
+                                    return;
+                                }
+                                if (solution.first == SolvingResult::Satisfiable) {
+                                    model = std::make_shared<const Assignment>(std::move(solution.second.value()));
+                                } else {
+                                    model = PartitionCache::Entry();
+                                }
+                                cache.Insert(partition, restriction, model.value());
+                            }
+                            if (!model.value()) {
+                                // prune all extensions of this cube
+                                pruned = true;
+                                break;
+                            }
+                            cube.models[partition] = model.value();
+                        }
+                        if (pruned) {
+                            break;
+                        }
+
+                        if (cube.depth == order.size()) {
+                            std::vector<Solution> solutions;
+                            for (const auto& model : cube.models) {
+                                solutions.push_back({SolvingResult::Satisfiable, *model});
+                            }
+                            auto result = Merge(problem, partitions, cutSet, cube.assignment, solutions);
+                            if (result.first == SolvingResult::Satisfiable) {
+                                std::lock_guard<std::mutex> lock(mutex);
+                                if (!satisfying) {
+                                    satisfying = std::move(result.second);
+                                }
+                                group.Cancel();
+                            }
+                            break;
+                        }
+
+                        auto variable = order[cube.depth];
+                        auto value = optimistic.GetState(variable) == VariableState::False ? VariableState::False : VariableState::True;
+                        if (cube.discrepancies < maxDiscrepancies) {
+                            Cube other{cube.assignment, cube.depth + 1, cube.models, cube.discrepancies + 1};
+                            other.assignment.SetState(variable, value == VariableState::True ? VariableState::False : VariableState::True);
+                            if (cube.depth < splitDepth) {
+                                group.Run([&explore, other = std::move(other)]() mutable {
+                                    explore(std::move(other));
+                                });
+                            } else {
+                                stack.push_back(std::move(other));
+                            }
+                        } else {
+                            limited = true;
+                        }
+
+                        cube.assignment.SetState(variable, value);
+                        cube.depth++;
+                    }
+                }
+            };
+            group.Run([&]() {
+                explore({Assignment(problem.GetNumberOfVariables()), 0, Models(partitions.size()), 0});
+            });
+            group.Wait();
+
+            if (satisfying || undefined || !limited) {
+                break;
+            }
+            maxDiscrepancies++;
+        }
+    } catch (...) {
+        cacheHits += cache.GetHits();
+        cacheMisses += cache.GetMisses();
+        StatsCollector::AddCacheHits(cache.GetHits());
+        throw;
+    }
+    cacheHits += cache.GetHits();
+    cacheMisses += cache.GetMisses();
+    StatsCollector::AddCacheHits(cache.GetHits());
+
+    if (satisfying) {
+        return {SolvingResult::Satisfiable, satisfying};
+    }
+    if (undefined) {
+        return {SolvingResult::Undefined, {}};
+    }
+    return {SolvingResult::Unsatisfiable, {}};
 }
 
-std::vector<Problem> AbstractPartitioner::CreateSubProblems(const Problem& problem, const std::vector<std::set<Variable>>& partitions, const Assignment& assignment)
+Solution AbstractPartitioner::SolvePartition(const Problem& problem, const RestrictionEngine& clauses, const Assignment& cube)
 {
-    auto simplifiedProblem = SimplifyClauses(problem.GetClauses(), assignment);
+    auto restriction = clauses.Restrict(cube);
+    if (restriction.conflict) {
+        return {SolvingResult::Unsatisfiable, {}};
+    }
 
-    // assign each clause to a subproblem
-    std::vector<std::vector<Clause>> subProblems(partitions.size());
-    for (size_t i = 0; i < partitions.size(); i++) {
-        for (auto& clause : simplifiedProblem) {
-            for (auto& literal : clause) {
-                CheckTimeLimit();
-                auto& partition = partitions[i];
-                if (partition.find(literal) != partition.end()
-                    || partition.find(Negate(literal)) != partition.end()) {
-                    subProblems[i].push_back(clause);
-                    break;
+    Assignment model(problem.GetNumberOfVariables());
+    if (!restriction.clauses.empty()) {
+        auto solution = SolveSubproblem(Problem(problem.GetNumberOfVariables(), std::move(restriction.clauses)), GetRemainingTimeLimit());
+        if (solution.first != SolvingResult::Satisfiable) {
+            return solution;
+        }
+        model = std::move(solution.second.value());
+    }
+    // the implied variables do not occur in the restricted clauses
+    for (auto literal : restriction.implied) {
+        model.SetState(ToVariable(literal), IsPositive(literal) ? VariableState::True : VariableState::False);
+    }
+    return {SolvingResult::Satisfiable, model};
+}
+
+Solution AbstractPartitioner::SolveSubproblem(const Problem& problem, OptionalTimeLimitMs subTimeLimit)
+{
+    TraceSpan span("SolveSubproblem", "solving");
+    StatsCollector::AddSubproblems(1);
+    if (bitSlicedThreshold > 0 && BitSlicedSolver::GetNumberOfUsedVariables(problem) <= bitSlicedThreshold) {
+        // cheaper than starting the partition solver
+        return BitSlicedSolver().Solve(problem, subTimeLimit);
+    }
+    if (!recursion || recursion->depth >= recursion->maxDepth || problem.GetClauses().size() <= recursion->leafSize) {
+        return partitionSolver->Solve(problem, subTimeLimit);
+    }
+
+    auto nestedStart = std::chrono::steady_clock::now();
+    auto nested = recursion->factory();
+    if (!nested) {
+        throw std::runtime_error("partitioner factory returned no partitioner");
+    }
+    nested->SetPartitionSolver(partitionSolver);
+    nested->recursion = recursion;
+    nested->recursion->depth++;
+    nested->bitSlicedThreshold = bitSlicedThreshold;
+    if (!nested->costModel) {
+        nested->costModel = costModel;
+    }
+
+    // the nested level only gets a share, so a bad decomposition leaves time for the partition solver
+    auto levelTimeLimit = subTimeLimit;
+    if (levelTimeLimit) {
+        levelTimeLimit = std::chrono::duration_cast<std::chrono::milliseconds>(levelTimeLimit.value() * recursion->levelShare);
+    }
+    // nested tasks run on the shared scheduler, waiting threads help executing them
+    auto solution = nested->Solve(problem, levelTimeLimit);
+    if (solution.first == SolvingResult::Satisfiable && solution.second) {
+        // the nested level leaves variables of satisfied clauses undefined, the callers expect a complete model
+        auto& model = solution.second.value();
+        for (const auto& clause : problem.GetClauses()) {
+            for (auto literal : clause) {
+                if (model.GetState(ToVariable(literal)) == VariableState::Undefined) {
+                    model.SetState(ToVariable(literal), VariableState::False);
                 }
             }
         }
     }
+    if (solution.first != SolvingResult::Undefined) {
+        return solution;
+    }
 
-    std::vector<Problem> ret;
-    for (auto& subProblem : subProblems) {
-        CheckTimeLimit();
-        ret.emplace_back(problem.GetNumberOfVariables(), subProblem);
+    CheckTimeLimit();
+    if (!HasRemaining(subTimeLimit, nestedStart)) {
+        return solution;
     }
-    return ret;
+    return partitionSolver->Solve(problem, GetRemaining(subTimeLimit, nestedStart));
 }
 
-std::vector<Clause> AbstractPartitioner::SimplifyClauses(const std::vector<Clause>& clauses, const Assignment& assignment)
+Projections AbstractPartitioner::EnumerateSubproblemProjections(const Problem& problem, const std::vector<Variable>& variables, OptionalTimeLimitMs subTimeLimit)
 {
-    auto copy = clauses;
-    SimplifyClausesDirect(copy, assignment);
-    return clauses;
+    TraceSpan span("EnumerateProjections", "solving");
+    StatsCollector::AddSubproblems(1);
+    if (bitSlicedThreshold > 0 && BitSlicedSolver::GetNumberOfUsedVariables(problem) <= bitSlicedThreshold) {
+        // all models in one sweep
+        return BitSlicedSolver().EnumerateProjections(problem, variables, subTimeLimit);
+    }
+    if (!recursion) {
+        return partitionSolver->EnumerateProjections(problem, variables, subTimeLimit);
+    }
+    return SATSolver::EnumerateByBlocking(problem, variables, subTimeLimit, [this](const auto& p, auto t) {
+        return SolveSubproblem(p, t);
+    });
 }
 
-void AbstractPartitioner::SimplifyClausesDirect(std::vector<Clause>& clauses, const Assignment& assignment)
+std::optional<bool> AbstractPartitioner::IsCheaperPartitioned(const std::vector<Problem>& problems, const std::vector<std::set<Variable>>& partitions, const std::set<Variable>& cutSet) const
 {
-    // delete clauses that are satisfied by the assignment
-    for (size_t i = 0; i < clauses.size(); i++) {
-        auto& clause = clauses[i];
-        auto simplifed = false;
-        for (auto& literal : clause) {
-            CheckTimeLimit();
-            if (assignment.IsSAT(literal)) {
-                // clause can be deleted as it is satisfied
-                clauses.erase(clauses.begin() + i);
-                i--;
-                break;
-            }
+    if (!costModel) {
+        return {};
+    }
+
+    // the partitions cover the clauses of the problem
+    std::vector<Clause> clauses;
+    std::vector<PartitionCost> costs;
+    for (size_t i = 0; i < problems.size(); i++) {
+        CheckTimeLimit();
+        clauses.insert(clauses.end(), problems[i].GetClauses().begin(), problems[i].GetClauses().end());
+
+        PartitionCost cost;
+        cost.features = CostModel::GetFeatures(problems[i]);
+        if (i < partitions.size()) {
+            auto cutVariables = std::count_if(partitions[i].begin(), partitions[i].end(), [&cutSet](auto variable) {
+                return cutSet.find(variable) != cutSet.end();
+            });
+            cost.repetitions = std::pow(2.0, static_cast<double>(cutVariables));
         }
+        costs.push_back(cost);
+    }
+    return IsCheaperPartitioned(CostModel::GetFeatures(clauses), costs);
+}
+
+std::optional<bool> AbstractPartitioner::IsCheaperPartitioned(const CostFeatures& problem, const std::vector<PartitionCost>& partitions) const
+{
+    if (!costModel) {
+        return {};
     }
+    return costModel->IsPartitioningCheaper(problem, partitions);
+}
+
+double AbstractPartitioner::EstimateDifficulty(const PartitionCost& cost) const
+{
+    // the prediction of the cost model overflows on large features, the weights of a TimeBudget must be finite
+    constexpr double MaxDifficulty = 1e12;
+    auto bound = [MaxDifficulty](double value) {
+        return std::isnan(value) ? 0.0 : std::clamp(value, 0.0, MaxDifficulty);
+    };
+
+    auto time = costModel
+        ? costModel->PredictSolveTime(cost.features)
+        : static_cast<double>(cost.features.clauses) * cost.features.averageClauseLength;
+    // empty subproblems still take a moment
+    return std::min((bound(time) + 1) * std::max(bound(cost.repetitions), 1.0), MaxDifficulty);
 }
 
 std::vector<Solution> AbstractPartitioner::SolveInternal(std::vector<Problem>& problems)
@@ -210,11 +591,34 @@ std::vector<Solution> AbstractPartitioner::SolveInternal(std::vector<Problem>& p
         }
     }
 
-    return partitionSolver->Solve(problems, GetRemainingTimeLimit());
+    if (!recursion) {
+        StatsCollector::AddSubproblems(problems.size());
+        return partitionSolver->Solve(problems, GetRemainingTimeLimit());
+    }
+
+    // large problems are decomposed again, the remaining time is split by their difficulty
+    std::vector<double> weights;
+    for (const auto& subProblem : problems) {
+        weights.push_back(EstimateDifficulty({CostModel::GetFeatures(subProblem), 1}));
+    }
+    TimeBudget budget(GetTimeLimit(), start, std::move(weights), TaskScheduler::GetShared().GetNumberOfThreads());
+
+    std::vector<Solution> solutions(problems.size(), Solution{SolvingResult::Undefined, {}});
+    TaskGroup group;
+    for (size_t i = 0; i < problems.size(); i++) {
+        group.Run([this, &problems, &solutions, &budget, i]() {
+            CheckTimeLimit();
+            solutions[i] = SolveSubproblem(problems[i], budget.Start(i));
+            budget.Finish(i);
+        });
+    }
+    group.Wait();
+    return solutions;
 }
 
 Solution AbstractPartitioner::Merge(const Problem& problem, const std::vector<std::set<Variable>>& partitions, const std::set<Variable>& cutSet, const Assignment& assignment, const std::vector<Solution> solutions)
 {
+    TraceSpan span("Merge", "partitioning");
     if (solutions.size() != partitions.size()) {
         throw std::runtime_error("number of solutions equal the number of partitions");
     }
@@ -233,18 +637,13 @@ Solution AbstractPartitioner::Merge(const Problem& problem, const std::vector<st
     auto finalAssignment = assignment;
     for (size_t i = 0; i < solutions.size(); i++) {
         auto& subAssignment = solutions[i].second.value();
-        auto& partition = partitions[i];
-        for (Variable variable = FirstVariable; variable <= problem.GetNumberOfVariables(); variable++) {
+        for (const auto& variable : partitions[i]) {
+            CheckTimeLimit();
             if (cutSet.find(variable) != cutSet.end()) {
                 // variable is in cut set and has not to be set
                 continue;
             }
 
-            if (partition.find(variable) == partition.end()) {
-                // variable does not belong to this partition
-                continue;
-            }
-
             finalAssignment.SetState(variable, subAssignment.GetState(variable));
         }
     }
@@ -257,7 +656,7 @@ void AbstractPartitioner::RemoveEmptyPartitions(std::vector<std::set<Variable>>&
     partitions.erase(std::remove_if(partitions.begin(), partitions.end(), [](auto p) {return p.empty(); }), partitions.end());
 }
 
-void AbstractPartitioner::BeforeSolve(const Problem& problem, OptionalTimeLimitMs optionalTimeLimit)
+void AbstractPartitioner::BeforeSolve(const Problem&, OptionalTimeLimitMs)
 {
 }
 
@@ -277,3 +676,16 @@ OptionalTimeLimitMs AbstractPartitioner::GetTimeLimit() const
 {
     return timeLimit;
 }
+
+std::chrono::steady_clock::time_point AbstractPartitioner::GetStart() const
+{
+    return start;
+}
+
+std::pmr::memory_resource* AbstractPartitioner::GetMemoryResource()
+{
+    if (!arena) {
+        return std::pmr::get_default_resource();
+    }
+    return arena->GetResource();
+}
@@ -2,15 +2,52 @@
 
 #include "Partitioning/DLLMakro.h"
 
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <optional>
 #include <vector>
 #include <set>
 
 #include "Core/Interfaces/SATPartitioner.h"
+#include "Core/Utility/CostModel.h"
+#include "Core/Utility/RestrictionEngine.h"
+#include "Partitioning/Utility/ClauseRouter.h"
+#include "Partitioning/Utility/SolveArena.h"
 
 class PARTITIONINING_API AbstractPartitioner : public SATPartitioner {
+public:
+    /// <summary>
+    /// subproblems with at most this number of used variables are enumerated in-process (see BitSlicedSolver)
+    /// </summary>
+    static const Variable DefaultBitSlicedThreshold = 20;
+
+    /// <summary>
+    /// Creates the partitioner of the next level, must be thread safe.
+    /// </summary>
+    using PartitionerFactory = std::function<std::shared_ptr<AbstractPartitioner>()>;
+
+private:
+    struct Recursion {
+        PartitionerFactory factory;
+        size_t leafSize;
+        size_t maxDepth;
+        double levelShare;
+        size_t depth;
+    };
+
 private:
     std::chrono::steady_clock::time_point start;
     OptionalTimeLimitMs timeLimit;
+    std::atomic<size_t> cacheHits{0};
+    std::atomic<size_t> cacheMisses{0};
+    std::optional<Recursion> recursion;
+    std::shared_ptr<const CostModel> costModel;
+    Variable bitSlicedThreshold = DefaultBitSlicedThreshold;
+    /// <summary>
+    /// only exists during Solve
+    /// </summary>
+    std::unique_ptr<SolveArena> arena;
 
 public:
     /// <summary>
@@ -23,6 +60,42 @@ public:
     /// <returns></returns>
     virtual Solution Solve(const Problem& problem, OptionalTimeLimitMs timeLimit) final override;
 
+    /// <summary>
+    /// number of partitions that were taken from the cache while enumerating the cubes (summed over all solves)
+    /// </summary>
+    /// <returns></returns>
+    size_t GetCacheHits() const;
+    /// <summary>
+    /// number of partitions that had to be solved while enumerating the cubes (summed over all solves)
+    /// </summary>
+    /// <returns></returns>
+    size_t GetCacheMisses() const;
+
+    /// <summary>
+    /// Enables the recursive mode: subproblems with more than leafSize clauses are decomposed again
+    /// by a new partitioner of the factory instead of being passed to the partition solver.
+    /// The nested partitioners use the same partition solver and recursion settings, one level deeper.
+    /// </summary>
+    /// <param name="factory">partitioner of the next level, may create the same type again</param>
+    /// <param name="leafSize">subproblems with at most this number of clauses go to the partition solver</param>
+    /// <param name="maxDepth">number of nested levels</param>
+    /// <param name="levelShare">share of the remaining time a nested level gets, the partition solver gets the rest if it fails</param>
+    void SetRecursion(PartitionerFactory factory, size_t leafSize, size_t maxDepth = 3, double levelShare = 0.5);
+
+    /// <summary>
+    /// Lets the partitioners decide between partitioned and direct solving by the predicted time
+    /// instead of their fixed rules. Nested partitioners inherit the cost model.
+    /// </summary>
+    /// <param name="model">calibrated for the partition solver, nullptr restores the fixed rules</param>
+    void SetCostModel(std::shared_ptr<const CostModel> model);
+
+    /// <summary>
+    /// Subproblems with at most this number of used variables are solved by the bit-sliced enumeration
+    /// instead of the partition solver. Nested partitioners inherit the threshold.
+    /// </summary>
+    /// <param name="threshold">0 disables the enumeration, at most BitSlicedSolver::MaxVariables</param>
+    void SetBitSlicedThreshold(Variable threshold);
+
 protected:
     /// <summary>
     /// may be overwritten to avoid using default structure
@@ -63,29 +136,96 @@ protected:
     virtual Assignment CreateOptimisticAssignment(const Problem& problem, std::set<Variable> cutSet);
 
     /// <summary>
-    /// not recursive
+    /// Sends every clause to the partition that contains its variables (see ClauseRouter).
+    /// Clauses with only cut variables go to the partition that can be solved first.
     /// </summary>
     /// <param name="problem"></param>
     /// <param name="partitions"></param>
     /// <param name="cutSet"></param>
-    /// <param name="assignment"></param>
+    /// <param name="order">cut variables in the order they are assigned</param>
+    /// <returns>clauses of each partition, none if a clause does not fit into any partition</returns>
+    virtual std::optional<std::vector<PartitionClauses>> RouteClauses(const Problem& problem, const std::vector<std::set<Variable>>& partitions, const std::set<Variable>& cutSet, const std::vector<Variable>& order);
+
+    /// <summary>
+    /// Orders the cut variables so that the cut variables of a partition are assigned together,
+    /// partitions with few cut variables first. A partition can be solved as soon as its cut variables are assigned.
+    /// </summary>
+    /// <param name="partitions"></param>
+    /// <param name="cutSet"></param>
     /// <returns></returns>
-    virtual Solution TrySolve(const Problem& problem, const std::vector<std::set<Variable>>& partitions, const std::set<Variable>& cutSet, const Assignment& assignment);
+    virtual std::vector<Variable> OrderCutVariables(const std::vector<std::set<Variable>>& partitions, const std::set<Variable>& cutSet);
 
-    /// /// <summary>
-    /// recursive
+    /// <summary>
+    /// Cube & conquer: enumerates the assignments of the cut variables (cubes) in parallel.
+    /// Each partition is solved as soon as the cube assigns all of its cut variables,
+    /// if it is unsatisfiable all extensions of the cube are skipped.
+    /// The results are cached per restriction of the cut variables of the partition.
+    /// The first satisfying cube cancels the remaining work.
+    /// The partition solver must be thread safe.
     /// </summary>
     /// <param name="problem"></param>
     /// <param name="partitions"></param>
     /// <param name="cutSet"></param>
-    /// <param name="assignment"></param>
-    /// <param name="depth"></param>
+    /// <param name="order">see OrderCutVariables</param>
+    /// <param name="clauses">see RouteClauses</param>
     /// <returns></returns>
-    virtual Solution TrySolve(const Problem& problem, const std::vector<std::set<Variable>>& partitions, const std::set<Variable>& cutSet, Assignment& assignment, Variable depth);
+    virtual Solution SolveCubes(const Problem& problem, const std::vector<std::set<Variable>>& partitions, const std::set<Variable>& cutSet, const std::vector<Variable>& order, const std::vector<PartitionClauses>& clauses);
+
+    /// <summary>
+    /// Solves the clauses of one partition restricted by the cube.
+    /// Cubes that falsify a clause after unit propagation are rejected without calling the partition solver.
+    /// </summary>
+    /// <param name="problem"></param>
+    /// <param name="clauses">clauses of the partition</param>
+    /// <param name="cube"></param>
+    /// <returns></returns>
+    virtual Solution SolvePartition(const Problem& problem, const RestrictionEngine& clauses, const Assignment& cube);
+
+    /// <summary>
+    /// Solves a subproblem with the partition solver. Tiny subproblems are enumerated in-process,
+    /// in recursive mode large subproblems are decomposed again with a nested partitioner.
+    /// Must not be used for the whole problem.
+    /// </summary>
+    /// <param name="problem"></param>
+    /// <param name="timeLimit"></param>
+    /// <returns></returns>
+    virtual Solution SolveSubproblem(const Problem& problem, OptionalTimeLimitMs timeLimit);
+
+    /// <summary>
+    /// Enumerates the projections of a subproblem (see SATSolver::EnumerateProjections).
+    /// Tiny subproblems are swept once in-process, otherwise the partition solver blocks the found projections,
+    /// in recursive mode each blocking round is solved with SolveSubproblem.
+    /// </summary>
+    /// <param name="problem"></param>
+    /// <param name="variables">projection variables</param>
+    /// <param name="timeLimit"></param>
+    /// <returns></returns>
+    virtual Projections EnumerateSubproblemProjections(const Problem& problem, const std::vector<Variable>& variables, OptionalTimeLimitMs timeLimit);
+
+    /// <summary>
+    /// Compares the predicted time of solving the partitions with solving their union directly.
+    /// Each partition is solved once per assignment of its cut variables.
+    /// </summary>
+    /// <param name="problems">clauses of each partition</param>
+    /// <param name="partitions"></param>
+    /// <param name="cutSet"></param>
+    /// <returns>none if there is no cost model</returns>
+    std::optional<bool> IsCheaperPartitioned(const std::vector<Problem>& problems, const std::vector<std::set<Variable>>& partitions, const std::set<Variable>& cutSet) const;
+    /// <summary>
+    /// see IsCheaperPartitioned
+    /// </summary>
+    /// <param name="problem"></param>
+    /// <param name="partitions"></param>
+    /// <returns>none if there is no cost model</returns>
+    std::optional<bool> IsCheaperPartitioned(const CostFeatures& problem, const std::vector<PartitionCost>& partitions) const;
+    /// <summary>
+    /// Weight of a subproblem in a TimeBudget: the predicted time if there is a cost model,
+    /// otherwise the number of literals, times the repetitions.
+    /// </summary>
+    /// <param name="cost"></param>
+    /// <returns>positive</returns>
+    double EstimateDifficulty(const PartitionCost& cost) const;
 
-    virtual std::vector<Problem> CreateSubProblems(const Problem& problem, const std::vector<std::set<Variable>>& partitions, const Assignment& assignment);
-    virtual std::vector<Clause> SimplifyClauses(const std::vector<Clause>& clauses, const Assignment& assignment);
-    virtual void SimplifyClausesDirect(std::vector<Clause>& clauses, const Assignment& assignment);
     virtual std::vector<Solution> SolveInternal(std::vector<Problem>& problems);
     virtual Solution Merge(const Problem& problem, const std::vector<std::set<Variable>>& partitions, const std::set<Variable>& cutSet, const Assignment& assignment, const std::vector<Solution> solutions);
     void RemoveEmptyPartitions(std::vector<std::set<Variable>>& partitions);
@@ -94,4 +234,14 @@ protected:
     virtual void CheckTimeLimit() const;
     virtual OptionalTimeLimitMs GetRemainingTimeLimit() const;
     virtual OptionalTimeLimitMs GetTimeLimit() const;
+    /// <summary>
+    /// begin of the running Solve, the time limit counts from here
+    /// </summary>
+    /// <returns></returns>
+    std::chrono::steady_clock::time_point GetStart() const;
+    /// <summary>
+    /// memory of the running Solve for the calling thread (see SolveArena), the default resource outside of Solve
+    /// </summary>
+    /// <returns></returns>
+    std::pmr::memory_resource* GetMemoryResource();
 };
\ No newline at end of file
@@ -0,0 +1,48 @@
+#include "Partitioning/stdafx.h"
+#include "CommunityPartitioner.h"
+
+#include "Partitioning/Utility/CommunityDetection.h"
+
+#include <algorithm>
+
+std::vector<std::set<Variable>> CommunityPartitioner::CreatePartitions(const Problem& problem)
+{
+    const auto& clauses = problem.GetClauses();
+    if (clauses.size() < 2) {
+        return {};
+    }
+
+    CheckTimeLimit();
+
+    auto checkTimeLimit = [this]() {
+        CheckTimeLimit();
+    };
+    auto graph = CreateVariableIncidenceGraph(problem.GetNumberOfVariables(), clauses);
+    auto communities = FindCommunities(graph, checkTimeLimit);
+    auto blocks = AssignClausesToCommunities(clauses, communities);
+
+    auto numberOfBlocks = communities.empty() ? 0 : *std::max_element(communities.begin(), communities.end()) + 1;
+    ShrinkBoundary(clauses, blocks, numberOfBlocks, Imbalance, checkTimeLimit);
+
+    // a partition consists of all variables of its clauses
+    std::vector<std::set<Variable>> partitions(numberOfBlocks);
+    for (size_t i = 0; i < clauses.size(); i++) {
+        for (auto literal : clauses[i]) {
+            partitions[blocks[i]].insert(ToVariable(literal));
+        }
+    }
+    RemoveEmptyPartitions(partitions);
+    return partitions;
+}
+
+bool CommunityPartitioner::IsGoodPartitioning(const std::vector<Problem>& problems, const std::vector<std::set<Variable>>& partitions, const std::set<Variable>& cutSet)
+{
+    auto nonEmpty = std::count_if(problems.begin(), problems.end(), [](const Problem& problem) {
+        return !problem.GetClauses().empty();
+    });
+    // the cut set contains both literals of every cut variable
+    if (nonEmpty < 2 || cutSet.size() / 2 > MaxCutSize) {
+        return false;
+    }
+    return IsCheaperPartitioned(problems, partitions, cutSet).value_or(true);
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "Partitioning/DLLMakro.h"
+
+#include "AbstractPartitioner.h"
+
+#include <set>
+#include <vector>
+
+/// <summary>
+/// Class to solve a problem by cube & conquer.
+/// The partitions are the communities (Louvain) of the variable incidence graph,
+/// afterwards clauses are moved between the partitions to reduce the cut.
+/// </summary>
+class PARTITIONINING_API CommunityPartitioner : public AbstractPartitioner {
+private:
+    /// <summary>
+    /// the cube enumerates all assignments of the cut, so it has to stay small
+    /// </summary>
+    static const size_t MaxCutSize = 16;
+    /// <summary>
+    /// factor a community may grow while shrinking the boundary
+    /// </summary>
+    static constexpr double Imbalance = 0.1;
+
+protected:
+    virtual std::vector<std::set<Variable>> CreatePartitions(const Problem& problem) override;
+    virtual bool IsGoodPartitioning(const std::vector<Problem>& problems, const std::vector<std::set<Variable>>& partitions, const std::set<Variable>& cutSet) override;
+};
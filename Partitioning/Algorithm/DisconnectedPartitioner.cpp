@@ -1,61 +1,65 @@
 #include "Partitioning/stdafx.h"
 #include "DisconnectedPartitioner.h"
 
-#include <map>
 #include <set>
-#include <algorithm>
-#include <iterator>
-#include <iostream>
+#include <cmath>
 
-std::vector<std::set<Variable>> DisconnectedPartitioner::CreatePartitions(const Problem & problem)
+Solution DisconnectedPartitioner::SolveExt(const Problem& problem, OptionalTimeLimitMs)
 {
-    // build neighbour list
-    std::vector<std::set<Variable>> partitions;
-    partitions.emplace_back(std::set<Variable>()); // variable 0
-    for (Variable i = FirstVariable; i <= problem.GetNumberOfVariables(); i++) {
-        partitions.emplace_back(std::set<Variable>());
+    auto components = FindConnectedComponentsParallel(problem);
+    CheckTimeLimit();
+    if (components.size() <= 1) {
+        // no valid partitions
+        return partitionSolver->Solve(problem, GetRemainingTimeLimit());
     }
 
-    // add neighbours
-    for (const auto& clause : problem.GetClauses()) {
+    // the components know their clauses, no need to route them again
+    std::vector<Problem> problems;
+    problems.reserve(components.size());
+    for (const auto& component : components) {
         CheckTimeLimit();
-        std::set<Variable> varClause;
-        std::transform(clause.begin(), clause.end(), std::inserter(varClause, varClause.begin()), [](auto lit) {
-            return ToVariable(lit);
-        });
-        for (const auto& var : varClause) {
-            partitions[var].insert(varClause.begin(), varClause.end());
+        std::vector<Clause> clauses;
+        clauses.reserve(component.clauses.size());
+        for (auto clause : component.clauses) {
+            clauses.push_back(problem.GetClauses()[clause]);
         }
+        problems.emplace_back(problem.GetNumberOfVariables(), std::move(clauses));
     }
 
-    // merge partitions
-    for (auto& partition : partitions) {
-        if (partition.empty()) {
-            continue;
-        }
+    auto partitions = ConvertComponents(components);
+    components.clear();
 
-        bool addedConnections = false;
-        do {
-            addedConnections = false;
-            for (const auto& var : partition) {
-                CheckTimeLimit();
-                auto& conntected = partitions[var];
-                if (!conntected.empty() && &partition != &conntected) {
-                    addedConnections = true;
-                    partition.insert(conntected.begin(), conntected.end());
-                    conntected.clear();
-                    break;
-                }
-            }
-        } while (addedConnections);
+    if (!IsGoodPartitioning(problems, partitions, {})) {
+        return partitionSolver->Solve(problem, GetRemainingTimeLimit());
     }
 
-    RemoveEmptyPartitions(partitions);
+    auto solutions = SolveInternal(problems);
+    return Merge(problem, partitions, {}, Assignment(problem.GetNumberOfVariables()), solutions);
+}
 
+std::vector<std::set<Variable>> DisconnectedPartitioner::CreatePartitions(const Problem& problem)
+{
+    auto partitions = ConvertComponents(FindConnectedComponentsParallel(problem));
+    RemoveEmptyPartitions(partitions);
     return partitions;
 }
 
 bool DisconnectedPartitioner::IsGoodPartitioning(const std::vector<Problem>& problems, const std::vector<std::set<Variable>>& partitions, const std::set<Variable>& cutSet)
 {
+    if (auto cheaper = IsCheaperPartitioned(problems, partitions, cutSet)) {
+        return cheaper.value();
+    }
     return problems.size() > std::pow(2, cutSet.size());
 }
+
+std::vector<std::set<Variable>> DisconnectedPartitioner::ConvertComponents(const std::vector<Component>& components)
+{
+    std::vector<std::set<Variable>> partitions;
+    partitions.reserve(components.size());
+    for (const auto& component : components) {
+        CheckTimeLimit();
+        // variables are sorted, hint at the end
+        partitions.emplace_back(component.variables.begin(), component.variables.end());
+    }
+    return partitions;
+}
@@ -3,12 +3,23 @@
 #include "Partitioning/DLLMakro.h"
 
 #include "AbstractPartitioner.h"
+#include "Core/Utility/ConnectedComponents.h"
 
 /// <summary>
 /// Class to solve a problem by cube & conquer.
 /// </summary>
 class PARTITIONINING_API DisconnectedPartitioner : public AbstractPartitioner {
 protected:
+    /// <summary>
+    /// builds the subproblems directly from the clause ids of the components
+    /// </summary>
+    /// <param name="problem"></param>
+    /// <param name="timeLimit"></param>
+    /// <returns></returns>
+    virtual Solution SolveExt(const Problem& problem, OptionalTimeLimitMs timeLimit) override;
     virtual std::vector<std::set<Variable>> CreatePartitions(const Problem& problem) override;
     virtual bool IsGoodPartitioning(const std::vector<Problem>& problems, const std::vector<std::set<Variable>>& partitions, const std::set<Variable>& cutSet) override;
-};
\ No newline at end of file
+
+private:
+    virtual std::vector<std::set<Variable>> ConvertComponents(const std::vector<Component>& components);
+};
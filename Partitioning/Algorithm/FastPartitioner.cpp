@@ -1,77 +1,107 @@
 #include "Partitioning/stdafx.h"
 #include "FastPartitioner.h"
 
-#include <map>
 #include <set>
 #include <algorithm>
-#include <iterator>
-#include <iostream>
+#include <numeric>
 
-#include "Partitioning/Utility/ClauseUtility.h"
+#include "Core/Utility/TaskScheduler.h"
+#include "Core/Utility/TimeBudget.h"
 
-Solution FastPartitioner::SolveExt(const Problem& problem, OptionalTimeLimitMs timeLimit)
+Solution FastPartitioner::SolveExt(const Problem& problem, OptionalTimeLimitMs)
 {
-    std::vector<std::vector<Clause>> subproblems;
-    std::vector<std::set<Variable>> partitions;
-
-    auto clauses = problem.GetClauses();
-
-    auto CreateNewPartition = [&]() {
-        subproblems.push_back({clauses[0]});
-        std::set<Variable> varClause;
-        std::transform(clauses[0].begin(), clauses[0].end(), std::inserter(varClause, varClause.begin()), [](auto lit) {
-            return ToVariable(lit);
-        });
-        partitions.push_back(varClause);
-        clauses.erase(clauses.begin());
-    };
-
-    CreateNewPartition();
+    auto components = FindConnectedComponentsParallel(problem);
+    CheckTimeLimit();
+    if (components.size() <= 1) {
+        // nothing to split
+        return partitionSolver->Solve(problem, GetRemainingTimeLimit());
+    }
 
-    for (size_t partition = 0; !clauses.empty(); partition++) {
-        bool foundOne = false;
-        for (size_t i = 0; i < clauses.size(); i++) {
-            CheckTimeLimit();
+    // largest first, the hardest component decides the total time
+    std::vector<size_t> order(components.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&components](auto l, auto r) {
+        return components[l].clauses.size() > components[r].clauses.size();
+    });
 
-            std::set<Variable> varClause;
-            std::transform(clauses[i].begin(), clauses[i].end(), std::inserter(varClause, varClause.begin()), [](auto lit) {
-                return ToVariable(lit);
-            });
-            if (IsConnected(partitions[partition], varClause)) {
-                foundOne = true;
-                subproblems[partition].push_back(clauses[i]);
-                partitions[partition].insert(varClause.begin(), varClause.end());
-                clauses.erase(clauses.begin() + i);
-                i--;
-            }
+    // the remaining time is split by the difficulty of the components
+    std::vector<double> weights;
+    for (const auto& component : components) {
+        CostFeatures features;
+        features.clauses = component.clauses.size();
+        features.variables = component.variables.size();
+        for (auto clause : component.clauses) {
+            features.averageClauseLength += problem.GetClauses()[clause].size();
         }
-        if (foundOne) {
-            partition--;
-        } else {
-            CreateNewPartition();
+        if (features.clauses > 0) {
+            features.averageClauseLength /= features.clauses;
         }
+        weights.push_back(EstimateDifficulty({features, 1}));
     }
+    TimeBudget budget(GetTimeLimit(), GetStart(), std::move(weights), TaskScheduler::GetShared().GetNumberOfThreads());
 
-    std::vector<Problem> problems;
-    for (auto& subproblem : subproblems) {
-        problems.emplace_back(problem.GetNumberOfVariables(), std::move(subproblem));
+    // the components are disjoint, so each task writes its own variables of the assignment
+    Assignment assignment(problem.GetNumberOfVariables());
+    std::vector<SolvingResult> results(components.size(), SolvingResult::Undefined);
+    {
+        TaskGroup group;
+        for (auto index : order) {
+            group.Run([this, &problem, &components, &assignment, &results, &group, &budget, index]() {
+                CheckTimeLimit();
+                auto compacted = CreateComponentProblem(problem, components[index]);
+                auto solution = SolveSubproblem(compacted.GetProblem(), budget.Start(index));
+                budget.Finish(index);
+                if (solution.first == SolvingResult::Unsatisfiable) {
+                    // one unsat component is enough
+                    group.Cancel();
+                }
+                if (solution.first == SolvingResult::Satisfiable) {
+                    if (!solution.second) {
+                        throw std::runtime_error("missing assignment for solution");
+                    }
+                    compacted.ExpandInto(solution.second.value(), assignment);
+                }
+                results[index] = solution.first;
+            });
+        }
+        group.Wait();
     }
-    subproblems.clear();
 
-    return {SolvingResult::Unsatisfiable, {}};
+    if (std::any_of(results.begin(), results.end(), [](auto result) {
+        return result == SolvingResult::Unsatisfiable;
+    })) {
+        return {SolvingResult::Unsatisfiable, {}};
+    }
+    if (std::any_of(results.begin(), results.end(), [](auto result) {
+        return result != SolvingResult::Satisfiable;
+    })) {
+        return {SolvingResult::Undefined, {}};
+    }
 
-    // Todo
-    // auto solutions = partitionSolver->Solve(problems, GetRemainingTimeLimit());
-    //
-    // return Merge(problem, partitions, {}, {problem.GetNumberOfVariables()}, solutions);
+    return {problem.Apply(assignment), assignment};
 }
 
 std::vector<std::set<Variable>> FastPartitioner::CreatePartitions(const Problem& problem)
 {
-    return std::vector<std::set<Variable>>();
+    std::vector<std::set<Variable>> partitions;
+    for (const auto& component : FindConnectedComponentsParallel(problem)) {
+        partitions.emplace_back(component.variables.begin(), component.variables.end());
+    }
+    RemoveEmptyPartitions(partitions);
+    return partitions;
 }
 
 bool FastPartitioner::IsGoodPartitioning(const std::vector<Problem>& problems, const std::vector<std::set<Variable>>& partitions, const std::set<Variable>& cutSet)
 {
     return true;
 }
+
+CompactedProblem FastPartitioner::CreateComponentProblem(const Problem& problem, const Component& component)
+{
+    std::vector<Clause> clauses;
+    clauses.reserve(component.clauses.size());
+    for (auto index : component.clauses) {
+        clauses.push_back(problem.GetClauses()[index]);
+    }
+    return CompactedProblem(problem.GetNumberOfVariables(), std::move(clauses));
+}
@@ -3,9 +3,13 @@
 #include "Partitioning/DLLMakro.h"
 
 #include "AbstractPartitioner.h"
+#include "Core/Utility/CompactedProblem.h"
+#include "Core/Utility/ConnectedComponents.h"
 
 /// <summary>
-/// Class to solve a problem by cube & conquer.
+/// Class to solve a problem by splitting it into its independent components,
+/// which are solved concurrently (largest first).
+/// The partition solver must be thread safe.
 /// </summary>
 class PARTITIONINING_API FastPartitioner : public AbstractPartitioner {
 public:
@@ -13,4 +17,13 @@ public:
 protected:
     virtual std::vector<std::set<Variable>> CreatePartitions(const Problem& problem) override;
     virtual bool IsGoodPartitioning(const std::vector<Problem>& problems, const std::vector<std::set<Variable>>& partitions, const std::set<Variable>& cutSet) override;
-};
\ No newline at end of file
+
+private:
+    /// <summary>
+    /// Component as problem with the variables 1..component.variables.size().
+    /// </summary>
+    /// <param name="problem"></param>
+    /// <param name="component"></param>
+    /// <returns></returns>
+    virtual CompactedProblem CreateComponentProblem(const Problem& problem, const Component& component);
+};
@@ -92,7 +92,8 @@ void GreedyPartitioner::AssignClauses(std::vector<std::set<Variable>>& partition
         CheckTimeLimit();
         auto clause = clauses[i];
         size_t max = 0;
-        std::sort(partitions.begin(), partitions.end(), [&clause, &max](auto l, auto r) {
+        // by reference, the sets were copied for every comparison
+        std::sort(partitions.begin(), partitions.end(), [&clause, &max](const auto& l, const auto& r) {
             auto c1 = GetConnectivity(clause, l);
             auto c2 = GetConnectivity(clause, r);
             max = std::max({max, c1, c2});
@@ -114,5 +115,5 @@ bool GreedyPartitioner::IsGoodPartitioning(const std::vector<Problem>& problems,
             counter++;
         }
     }
-    return counter >= 2;
+    return counter >= 2 && IsCheaperPartitioned(problems, partitions, cutSet).value_or(true);
 }
@@ -0,0 +1,54 @@
+#include "Partitioning/stdafx.h"
+#include "MultilevelPartitioner.h"
+
+#include "Partitioning/Utility/Hypergraph.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+MultilevelPartitioner::MultilevelPartitioner(size_t numberOfPartitions, double imbalance) :
+    numberOfPartitions(numberOfPartitions),
+    imbalance(imbalance)
+{
+    if (numberOfPartitions < 2) {
+        throw std::invalid_argument("multilevel partitioner needs at least two partitions");
+    }
+}
+
+std::vector<std::set<Variable>> MultilevelPartitioner::CreatePartitions(const Problem& problem)
+{
+    if (problem.GetClauses().size() < 2) {
+        return {};
+    }
+
+    CheckTimeLimit();
+
+    // clauses are the vertices, so the cut nets are exactly the cut variables
+    auto hypergraph = Hypergraph::FromClauses(problem);
+    auto blocks = PartitionHypergraph(hypergraph, numberOfPartitions, imbalance, Seed, [this]() {
+        CheckTimeLimit();
+    });
+
+    // a partition consists of all variables of its clauses
+    std::vector<std::set<Variable>> partitions(numberOfPartitions);
+    const auto& clauses = problem.GetClauses();
+    for (size_t i = 0; i < clauses.size(); i++) {
+        for (auto literal : clauses[i]) {
+            partitions[blocks[i]].insert(ToVariable(literal));
+        }
+    }
+    RemoveEmptyPartitions(partitions);
+    return partitions;
+}
+
+bool MultilevelPartitioner::IsGoodPartitioning(const std::vector<Problem>& problems, const std::vector<std::set<Variable>>& partitions, const std::set<Variable>& cutSet)
+{
+    auto nonEmpty = std::count_if(problems.begin(), problems.end(), [](const Problem& problem) {
+        return !problem.GetClauses().empty();
+    });
+    // the cut set contains both literals of every cut variable
+    if (nonEmpty < 2 || cutSet.size() / 2 > MaxCutSize) {
+        return false;
+    }
+    return IsCheaperPartitioned(problems, partitions, cutSet).value_or(true);
+}
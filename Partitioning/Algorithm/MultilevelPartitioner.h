@@ -0,0 +1,38 @@
+#pragma once
+
+#include "Partitioning/DLLMakro.h"
+
+#include "AbstractPartitioner.h"
+
+#include <set>
+#include <vector>
+
+/// <summary>
+/// Class to solve a problem by cube & conquer.
+/// The clauses are partitioned with a multilevel hypergraph partitioner,
+/// which minimizes the number of variables that are shared between partitions.
+/// </summary>
+class PARTITIONINING_API MultilevelPartitioner : public AbstractPartitioner {
+private:
+    /// <summary>
+    /// the cube enumerates all assignments of the cut, so it has to stay small
+    /// </summary>
+    static const size_t MaxCutSize = 16;
+    static const uint64_t Seed = 0;
+
+private:
+    size_t numberOfPartitions;
+    double imbalance;
+
+public:
+    /// <summary>
+    ///
+    /// </summary>
+    /// <param name="numberOfPartitions">k of the k-way partitioning</param>
+    /// <param name="imbalance">every partition may have up to (1 + imbalance) times its share of the clauses</param>
+    MultilevelPartitioner(size_t numberOfPartitions = 2, double imbalance = 0.1);
+
+protected:
+    virtual std::vector<std::set<Variable>> CreatePartitions(const Problem& problem) override;
+    virtual bool IsGoodPartitioning(const std::vector<Problem>& problems, const std::vector<std::set<Variable>>& partitions, const std::set<Variable>& cutSet) override;
+};
@@ -1,14 +1,18 @@
 #include "Partitioning/stdafx.h"
 #include "OnePointPartitioner.h"
 
-#include "Partitioning/Utility/ClauseUtility.h"
+#include "Partitioning/Utility/CommunityDetection.h"
 
 #include <algorithm>
+#include <cmath>
+#include <functional>
 #include <iterator>
+#include <mutex>
 
-// Todo
-#include <fstream>
-const char* TempFile = "instance/debug.csv";
+#include "Core/Utility/StatsCollector.h"
+#include "Core/Utility/TaskScheduler.h"
+#include "Core/Utility/TimeBudget.h"
+#include "Core/Utility/Trace.h"
 
 template <class T>
 void SortBySizeDesc(std::vector<T>& vec)
@@ -28,23 +32,17 @@ Solution OnePointPartitioner::SolveExt(const Problem& problem, OptionalTimeLimit
 
     SortBySizeDesc(clauses);
 
-    // transform each clause into subproblem & partition
-    auto partitions = ConvertClauses(clauses);
+    // transform each clause (or community of large problems) into subproblem & partition
+    TraceSpan createSpan("CreatePartitions", "partitioning");
+    auto partitions = clauses.size() > CommunityThreshold
+        ? ConvertCommunities(problem.GetNumberOfVariables(), clauses)
+        : ConvertClauses(clauses);
+    createSpan.End();
 
-    // merge partitions if they have at least two connections
-    MergePartitionsC2(partitions);
-
-    // merge clauses, if they only have one single connection with only one other partition
-    auto looseClauses = MergeClauses1(partitions);
-
-    // merge partitions if they have at least two connections
-    MergePartitionsC2(partitions);
-
-    // add connection clauses to the smallest partition
-    MergeConnections(partitions);
-
-    // merge partitions if they have at least two connections
-    MergePartitionsC2(partitions);
+    // merge partitions along their shared variables
+    TraceSpan mergeSpan("MergePartitions", "partitioning");
+    auto looseClauses = MergePartitions(problem.GetNumberOfVariables(), partitions);
+    mergeSpan.End();
 
     // solve subproblems
     auto result = SolveSubproblems(problem, partitions);
@@ -57,152 +55,102 @@ Solution OnePointPartitioner::SolveExt(const Problem& problem, OptionalTimeLimit
 
 std::vector<Partition> OnePointPartitioner::ConvertClauses(std::vector<Clause>& clauses)
 {
+    // one set per clause, they all die with the solve
+    auto resource = GetMemoryResource();
     std::vector<Partition> partitions;
-
-    while (!clauses.empty()) {
+    partitions.reserve(clauses.size());
+    for (auto& clause : clauses) {
         CheckTimeLimit();
 
-        std::set<Variable> varClause;
-        std::transform(clauses[0].begin(), clauses[0].end(), std::inserter(varClause, varClause.begin()), [](auto lit) {
+        std::pmr::set<Variable> varClause(resource);
+        std::transform(clause.begin(), clause.end(), std::inserter(varClause, varClause.begin()), [](auto lit) {
             return ToVariable(lit);
         });
-        partitions.emplace_back(std::vector<Clause>{clauses[0]}, varClause);
-        clauses.erase(clauses.begin());
-
+        partitions.emplace_back(std::vector<Clause>{std::move(clause)}, std::move(varClause));
     }
+    clauses.clear();
     return partitions;
 }
 
-void OnePointPartitioner::MergePartitions(std::vector<Partition>& partitions, size_t& into, size_t& from)
+std::vector<Partition> OnePointPartitioner::ConvertCommunities(Variable numberOfVariables, std::vector<Clause>& clauses)
 {
-    // merge
-    partitions[into].clauses.insert(partitions[into].clauses.end(), partitions[from].clauses.begin(), partitions[from].clauses.end());
-    partitions[into].variables.insert(partitions[from].variables.begin(), partitions[from].variables.end());
-    partitions.erase(partitions.begin() + from);
-
-    // update indices
-    if (from < into) {
-        into--;
+    auto checkTimeLimit = [this]() {
+        CheckTimeLimit();
+    };
+    auto graph = CreateVariableIncidenceGraph(numberOfVariables, clauses);
+    auto communities = FindCommunities(graph, checkTimeLimit);
+    auto blocks = AssignClausesToCommunities(clauses, communities);
+
+    std::vector<std::vector<Clause>> communityClauses(communities.empty() ? 0 : *std::max_element(communities.begin(), communities.end()) + 1);
+    for (size_t i = 0; i < clauses.size(); i++) {
+        communityClauses[blocks[i]].push_back(std::move(clauses[i]));
     }
-    from--;
-}
+    clauses.clear();
 
-void OnePointPartitioner::DeletePartition(std::vector<Partition>& partitions, size_t & position)
-{
-    partitions.erase(partitions.begin() + position);
-    position--;
-}
-
-void OnePointPartitioner::MergePartitionsC2(std::vector<Partition>& partitions)
-{
-    const size_t MinMergeConnectivity = 2;
-    for (size_t i = 0; i < partitions.size(); i++) {
-        for (size_t j = 0; j < partitions.size(); j++) {
-            if (i == j) {
-                continue;
-            }
-            CheckTimeLimit();
-            if (GetConnectivity(partitions[i].variables, partitions[j].variables) >= MinMergeConnectivity) {
-                MergePartitions(partitions, i, j);
-            }
+    auto resource = GetMemoryResource();
+    std::vector<Partition> partitions;
+    for (auto& partitionClauses : communityClauses) {
+        CheckTimeLimit();
+        if (partitionClauses.empty()) {
+            continue;
+        }
+        std::pmr::set<Variable> variables(resource);
+        for (const auto& clause : partitionClauses) {
+            std::transform(clause.begin(), clause.end(), std::inserter(variables, variables.begin()), [](auto lit) {
+                return ToVariable(lit);
+            });
         }
+        partitions.emplace_back(std::move(partitionClauses), std::move(variables));
     }
+    return partitions;
 }
 
-std::vector<Clause> OnePointPartitioner::MergeClauses1(std::vector<Partition>& partitions)
+std::vector<Clause> OnePointPartitioner::MergePartitions(Variable numberOfVariables, std::vector<Partition>& partitions)
 {
-    std::vector<Clause> looseClauses;
-    for (size_t i = 0; i < partitions.size(); i++) {
-        if (partitions[i].clauses.size() > 1) {
-            // not a single clause
-            continue;
-        }
+    auto checkTimeLimit = [this]() {
+        CheckTimeLimit();
+    };
+    PartitionGraph graph(numberOfVariables, std::move(partitions));
 
-        const auto& clause = partitions[i].variables;
-        std::optional<size_t> candidatePartition;
-        bool isConnectedClause = false;
-        bool hasMany = false;
-        for (size_t j = 0; j < partitions.size(); j++) {
-            if (i == j) {
-                continue;
-            }
-            CheckTimeLimit();
-            if (GetConnectivity(clause, partitions[j].variables) >= 1) {
-                if (candidatePartition.has_value() && !isConnectedClause) {
-                    // multiple candidates -> cancel
-                    hasMany = true;
-                    break;
-                } else {
-                    candidatePartition = j;
+    // merge partitions if they have at least two connections
+    graph.MergeSharedPairs(checkTimeLimit);
 
-                    // is this only a connection to another clause?
-                    isConnectedClause = partitions[j].clauses.size() == 1;
-                }
-            }
-        }
-        if (!candidatePartition.has_value()) {
-            // this clause is loose
-            looseClauses.push_back(std::move(partitions[i].clauses[0]));
-            DeletePartition(partitions, i);
-        }
-        if (!hasMany && candidatePartition.has_value()) {
-            // merge clause into partition
-            MergePartitions(partitions, candidatePartition.value(), i);
-        }
-    }
+    // merge clauses, if they only have one single connection with only one other partition
+    auto looseClauses = graph.MergeSingleClauses(checkTimeLimit);
 
-    return looseClauses;
-}
+    // merge partitions if they have at least two connections
+    graph.MergeSharedPairs(checkTimeLimit);
 
-void OnePointPartitioner::MergeConnections(std::vector<Partition>& partitions)
-{
-    std::sort(partitions.begin(), partitions.end(), [](const auto& l, const auto& r) {
-        return l.clauses.size() < r.clauses.size();
-    });
+    // add connection clauses to the smallest partition
+    graph.MergeConnections(checkTimeLimit);
 
-    // assumption: added connections don't dramaticly change the size of partitions
-    for (size_t i = 0; i < partitions.size(); i++) {
-        if (partitions[i].clauses.size() != 1) {
-            // not a connection
-            continue;
-        }
-        for (size_t j = 0; j < partitions.size(); j++) {
-            CheckTimeLimit();
-            if (i == j) {
-                continue;
-            }
-            if (GetConnectivity(partitions[i].variables, partitions[j].variables) >= 1) {
-                MergePartitions(partitions, j, i);
-                break;
-            }
-        }
-    }
+    // merge partitions if they have at least two connections
+    graph.MergeSharedPairs(checkTimeLimit);
+
+    partitions = graph.ExtractPartitions();
+    return looseClauses;
 }
 
 Solution OnePointPartitioner::SolveSubproblems(const Problem& problem, std::vector<Partition>& partitions)
 {
+    TraceSpan cutSpan("FindCutSet", "partitioning");
     auto cutSet = FindCutSet(partitions);
+    cutSpan.End();
 
     if (!IsGoodPartitioning(partitions, cutSet)) {
-#ifdef _DEBUG
-        {
-            std::ofstream outfile(TempFile, std::fstream::app);
-            if (outfile) {
-                outfile << problem.GetClauses().size() << ";" << -1 << std::endl;
-            }
-        }
-#endif
-        return partitionSolver->Solve(problem, GetTimeLimit());
+        return partitionSolver->Solve(problem, GetRemainingTimeLimit());
     }
+    StatsCollector::AddCutSize(cutSet.size());
 
     std::sort(partitions.begin(), partitions.end(), [](const auto& l, const auto& r) {
         return l.clauses.size() < r.clauses.size();
     });
 
-    auto centerPartition = partitions.back();
+    auto centerPartition = std::move(partitions.back());
     partitions.pop_back();
 
     // create individual cutSets and truth tables
+    TraceSpan tablesSpan("CreateTruthTables", "partitioning");
     std::vector<std::set<Variable>> cutSetSubProblems;
     std::vector<std::vector<PartialAssignment>> truthTables;
     for (const auto& partitition : partitions) {
@@ -222,34 +170,157 @@ Solution OnePointPartitioner::SolveSubproblems(const Problem& problem, std::vect
     }
 
     cutSet.clear();
+    tablesSpan.End();
+
+    // the time left is split among the partitions by their difficulty, the center problem is the last job;
+    // the center problem is solved early whenever the number of finished partitions doubled,
+    // each of these speculative solves is a small job of its own
+    auto numberOfJobs = partitions.size();
+    std::vector<double> weights;
+    for (size_t partition = 0; partition < numberOfJobs; partition++) {
+        weights.push_back(EstimateDifficulty({CostModel::GetFeatures(partitions[partition].clauses), static_cast<double>(truthTables[partition].size())}));
+    }
+    auto centerWeight = EstimateDifficulty({CostModel::GetFeatures(centerPartition.clauses), 1});
+    auto firstSpeculationJob = weights.size();
+    for (size_t threshold = 1; threshold < numberOfJobs; threshold *= 2) {
+        weights.push_back(centerWeight * SpeculationWeight);
+    }
+    auto centerJob = weights.size();
+    weights.push_back(centerWeight);
+    TimeBudget budget(GetTimeLimit(), GetStart(), std::move(weights), TaskScheduler::GetShared().GetNumberOfThreads());
+
+    // the extendable rows of each partition are enumerated at once, every partition is an independent job
+    std::vector<std::vector<Solution>> solutions(numberOfJobs);
+    for (size_t partition = 0; partition < numberOfJobs; partition++) {
+        solutions[partition].assign(truthTables[partition].size(), {SolvingResult::Undefined, {}});
+    }
 
-    // give solving again the time of time limit
-    auto solvingStart = std::chrono::steady_clock::now();
+    std::mutex mutex;
+    std::optional<Solution> decided;
+    bool undefined = false;
+    size_t finishedJobs = 0;
+    size_t nextSpeculation = 1;
+    auto nextSpeculationJob = firstSpeculationJob;
+    bool speculating = false;
+    TaskGroup group;
+
+    // Solves the center problem with the blocking clauses known so far.
+    // Unsatisfiable stays unsatisfiable with more clauses. A model is final
+    // if every unfinished partition extends the row it selects, which is a single restricted solve each.
+    std::function<void(size_t)> speculate = [&](size_t job) {
+        TraceSpan span("Speculative center problem", "solving");
+        auto speculationStart = std::chrono::steady_clock::now();
+        auto speculationLimit = budget.Start(job);
+        std::optional<Problem> centerProblem;
+        std::vector<size_t> unknownPartitions;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            centerProblem = CreateCenterProblem(problem, centerPartition, cutSetSubProblems, truthTables, solutions);
+        }
+        auto solution = SolveSubproblem(centerProblem.value(), speculationLimit);
+
+        std::vector<std::pair<size_t, Solution>> rows;
+        if (solution.first == SolvingResult::Satisfiable) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                for (size_t partition = 0; partition < numberOfJobs; partition++) {
+                    auto row = GetRow(cutSetSubProblems[partition], solution.second.value());
+                    if (solutions[partition][row].first != SolvingResult::Satisfiable) {
+                        unknownPartitions.push_back(partition);
+                    }
+                }
+            }
+            for (auto partition : unknownPartitions) {
+                if (group.IsCancelled()) {
+                    break;
+                }
+                auto row = GetRow(cutSetSubProblems[partition], solution.second.value());
+                auto clauses = partitions[partition].clauses;
+                for (auto variable : cutSetSubProblems[partition]) {
+                    clauses.push_back({truthTables[partition][row].GetState(variable) == VariableState::True ? variable : Negate(variable)});
+                }
+                auto restricted = SolveSubproblem(Problem(problem.GetNumberOfVariables(), std::move(clauses)), GetRemaining(speculationLimit, speculationStart));
+                if (restricted.first != SolvingResult::Satisfiable) {
+                    break;
+                }
+                rows.emplace_back(row, std::move(restricted));
+            }
+        }
+        budget.Finish(job);
 
-    std::vector<std::vector<Solution>> solutions;
-    for (size_t partition = 0; partition < partitions.size(); partition++) {
-        // create subproblems
-        auto subProblems = CreateSubProblems(problem, partitions[partition], cutSetSubProblems[partition], truthTables[partition]);
-
-        // solve subproblems
-        auto subSolutions = partitionSolver->Solve(subProblems, GetRemaining(GetTimeLimit(), solvingStart));
-
-        // check solutions (if there are some)
-        if (std::all_of(subSolutions.begin(), subSolutions.end(), [](const auto& sol) {
-            return sol.first == SolvingResult::Unsatisfiable;
-        })) {
-            // all unsat
-            return {SolvingResult::Unsatisfiable, {}};
+        std::lock_guard<std::mutex> lock(mutex);
+        speculating = false;
+        if (decided || solution.first == SolvingResult::Undefined) {
+            return;
         }
-        if (std::any_of(subSolutions.begin(), subSolutions.end(), [](const auto& sol) {
-            return sol.first == SolvingResult::Undefined;
-        })) {
-            // some are undef
-            return {SolvingResult::Undefined, {}};
+        if (solution.first == SolvingResult::Unsatisfiable) {
+            decided = solution;
+            group.Cancel();
+            return;
         }
+        if (rows.size() != unknownPartitions.size()) {
+            // some selected row is not extendable or unknown
+            return;
+        }
+        // a witness of a row stays valid, the enumeration replaces the rows of its partition anyway
+        for (size_t i = 0; i < rows.size(); i++) {
+            solutions[unknownPartitions[i]][rows[i].first] = std::move(rows[i].second);
+        }
+        decided = CompleteAssignment(solution, partitions, truthTables, solutions);
+        group.Cancel();
+    };
+
+    for (size_t partition = 0; partition < partitions.size(); partition++) {
+        group.Run([&, partition]() {
+            CheckTimeLimit();
+            Problem subProblem(problem.GetNumberOfVariables(), partitions[partition].clauses);
+            std::vector<Variable> projection(cutSetSubProblems[partition].begin(), cutSetSubProblems[partition].end());
+            auto projections = EnumerateSubproblemProjections(subProblem, projection, budget.Start(partition));
+            budget.Finish(partition);
+
+            // rows without a witness are not extendable
+            std::vector<Solution> rows(truthTables[partition].size(), {SolvingResult::Unsatisfiable, {}});
+            for (auto& witness : projections.second) {
+                auto row = GetRow(cutSetSubProblems[partition], witness);
+                rows[row] = {SolvingResult::Satisfiable, std::move(witness)};
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (projections.first == SolvingResult::Undefined) {
+                // some are undef
+                undefined = true;
+                group.Cancel();
+                return;
+            }
+            solutions[partition] = std::move(rows);
+            finishedJobs++;
+            if (projections.first == SolvingResult::Unsatisfiable) {
+                // all unsat
+                decided = Solution {SolvingResult::Unsatisfiable, {}};
+                group.Cancel();
+                return;
+            }
+            if (!decided && !speculating && finishedJobs >= nextSpeculation && finishedJobs < numberOfJobs) {
+                speculating = true;
+                while (nextSpeculation <= finishedJobs) {
+                    nextSpeculation *= 2;
+                }
+                group.Run([&speculate, job = nextSpeculationJob++]() {
+                    speculate(job);
+                });
+            }
+        });
+    }
+    group.Wait();
 
-        // all good
-        solutions.push_back(subSolutions);
+    if (decided) {
+        return decided.value();
+    }
+    if (undefined) {
+        return {SolvingResult::Undefined, {}};
+    }
+    for (; nextSpeculationJob < centerJob; nextSpeculationJob++) {
+        budget.Skip(nextSpeculationJob);
     }
 
     // puzzle sub solutions together
@@ -258,18 +329,7 @@ Solution OnePointPartitioner::SolveSubproblems(const Problem& problem, std::vect
     cutSetSubProblems.clear();
 
     // solve final problem
-    auto solution = partitionSolver->Solve(centerProblem, GetRemaining(GetTimeLimit(), solvingStart));
-
-#ifdef _DEBUG
-    {
-        auto solvingEnd = std::chrono::steady_clock::now();
-
-        std::ofstream outfile(TempFile, std::fstream::app);
-        if (outfile) {
-            outfile << problem.GetClauses().size() << ";" << (std::chrono::duration_cast<std::chrono::milliseconds>(solvingEnd - solvingStart).count()) << std::endl;
-        }
-    }
-#endif
+    auto solution = SolveSubproblem(centerProblem, budget.Start(centerJob));
 
     // check if there is a solution
     if (solution.first != SolvingResult::Satisfiable || !solution.second.has_value()) {
@@ -290,22 +350,14 @@ Solution OnePointPartitioner::SolveSubproblems(const Problem& problem, std::vect
     */
 }
 
-std::vector<Problem> OnePointPartitioner::CreateSubProblems(const Problem& problem, const Partition& partition, const std::set<Variable>& subCutSet, const std::vector<PartialAssignment>& truthTable)
+size_t OnePointPartitioner::GetRow(const std::set<Variable>& subCutSet, const Assignment& assignment)
 {
-    std::vector<Problem> ret;
-    for (const auto& assignment : truthTable) {
-        std::vector<Clause> clauses = partition.clauses;
-        for (const auto& variable : subCutSet) {
-            if (assignment.GetState(variable) == VariableState::True) {
-                clauses.push_back({variable});
-            }
-            if (assignment.GetState(variable) == VariableState::False) {
-                clauses.push_back({Negate(variable)});
-            }
-        }
-        ret.emplace_back(problem.GetNumberOfVariables(), clauses);
+    // CreateTruthTable: the first variable is the most significant, True before False
+    size_t row = 0;
+    for (auto variable : subCutSet) {
+        row = 2 * row + (assignment.GetState(variable) == VariableState::True ? 0 : 1);
     }
-    return ret;
+    return row;
 }
 
 Clause CreateClause(const std::set<Variable>& cutSet, const PartialAssignment& assignment)
@@ -350,12 +402,25 @@ Problem OnePointPartitioner::CreateCenterProblem(const Problem& problem, const P
 
 Solution OnePointPartitioner::CompleteAssignment(const Solution& solution, std::vector<Partition>& partitions, const std::vector<std::vector<PartialAssignment>>& truthTable, const std::vector<std::vector<Solution>>& partitionSolutions)
 {
+    TraceSpan span("CompleteAssignment", "partitioning");
     if (partitions.size() != truthTable.size() || truthTable.size() != partitionSolutions.size()) {
         throw std::runtime_error("wrong dimension");
     }
 
     auto assignment = solution.second.value();
 
+    // cut variables that do not occur in the center problem are free, GetRow reads them as False
+    for (size_t partition = 0; partition < truthTable.size(); partition++) {
+        if (truthTable[partition].empty()) {
+            continue;
+        }
+        for (auto variable : partitions[partition].variables) {
+            if (truthTable[partition].front().HasState(variable) && assignment.GetState(variable) == VariableState::Undefined) {
+                assignment.SetState(variable, VariableState::False);
+            }
+        }
+    }
+
     for (size_t partition = 0; partition < partitionSolutions.size(); partition++) {
         for (size_t solution = 0; solution < partitionSolutions[partition].size(); solution++) {
             const auto& sol = partitionSolutions[partition][solution];
@@ -363,11 +428,16 @@ Solution OnePointPartitioner::CompleteAssignment(const Solution& solution, std::
                 continue;
             }
 
-            if (truthTable[partition][solution].IsCompatible(assignment)) {
+            const auto& row = truthTable[partition][solution];
+            if (row.IsCompatible(assignment)) {
                 // this condition shall only be true for one solution per partition
 
                 const auto& subAssignment = sol.second.value();
                 for (const auto& variable : partitions[partition].variables) {
+                    if (row.HasState(variable)) {
+                        // cut variable, already set by the center problem
+                        continue;
+                    }
                     assignment.SetState(variable, subAssignment.GetState(variable));
                 }
                 break;
@@ -378,21 +448,6 @@ Solution OnePointPartitioner::CompleteAssignment(const Solution& solution, std::
     return {solution.first, assignment};
 }
 
-std::vector<Partition> OnePointPartitioner::ExtractConnections(std::vector<Partition>& partitions)
-{
-    std::vector<Partition> connections;
-    for (size_t i = 0; i < partitions.size(); i++) {
-        if (partitions[i].clauses.size() != 1) {
-            // not a connection
-            continue;
-        }
-        CheckTimeLimit();
-        connections.push_back(std::move(partitions[i]));
-        DeletePartition(partitions, i);
-    }
-    return connections;
-}
-
 std::set<Variable> OnePointPartitioner::FindCutSet(const std::vector<Partition>& partitions)
 {
     // vector of all variables (with duplicates)
@@ -493,7 +548,25 @@ void OnePointPartitioner::AddSolutionLoose(Assignment& assignment, std::vector<C
 
 bool OnePointPartitioner::IsGoodPartitioning(const std::vector<Partition>& partitions, const std::set<Variable>& cutSet)
 {
-    return partitions.size() > 1 && cutSet.size() <= partitions.size();
+    if (partitions.size() <= 1) {
+        return false;
+    }
+
+    // every partition is solved once per row of its truth table
+    std::vector<Clause> clauses;
+    std::vector<PartitionCost> costs;
+    for (const auto& partition : partitions) {
+        CheckTimeLimit();
+        clauses.insert(clauses.end(), partition.clauses.begin(), partition.clauses.end());
+        auto cutVariables = std::count_if(partition.variables.begin(), partition.variables.end(), [&cutSet](auto variable) {
+            return cutSet.find(variable) != cutSet.end();
+        });
+        costs.push_back({CostModel::GetFeatures(partition.clauses), std::pow(2.0, static_cast<double>(cutVariables))});
+    }
+    if (auto cheaper = IsCheaperPartitioned(CostModel::GetFeatures(clauses), costs)) {
+        return cheaper.value();
+    }
+    return cutSet.size() <= partitions.size();
 }
 
 std::vector<std::set<Variable>> OnePointPartitioner::CreatePartitions(const Problem& problem)
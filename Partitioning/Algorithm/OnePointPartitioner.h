@@ -4,71 +4,61 @@
 
 #include "AbstractPartitioner.h"
 #include "Core/Utility/PartialAssignment.h"
-
-struct Partition {
-    std::vector<Clause> clauses;
-    std::set<Variable> variables;
-
-    Partition(const std::vector<Clause>& clauses, const std::set<Variable>& variables) :
-        clauses(clauses), variables(variables)
-    {
-    }
-
-    Partition(std::vector<Clause>&& clauses, std::set<Variable>&& variables) :
-        clauses(clauses), variables(variables)
-    {
-    }
-    Partition(const Partition& other) :
-        clauses(other.clauses), variables(other.variables)
-    {
-    }
-
-    Partition(Partition&& other) :
-        clauses(std::move(other.clauses)), variables(std::move(other.variables))
-    {
-    }
-    Partition& operator=(const Partition& other)
-    {
-        if (&other != this) {
-            clauses = other.clauses;
-            variables = other.variables;
-        }
-        return *this;
-    }
-    Partition& operator=(Partition&& other)
-    {
-        if (&other != this) {
-            clauses = std::move(other.clauses);
-            variables = std::move(other.variables);
-        }
-        return *this;
-    }
-};
+#include "Partitioning/Utility/PartitionGraph.h"
 
 /// <summary>
 /// Class to solve problems that consist of multiple problems
 /// which are connected via only one variable.
 /// </summary>
 class PARTITIONINING_API OnePointPartitioner : public AbstractPartitioner {
+private:
+    /// <summary>
+    /// problems with more clauses start with their communities instead of single clauses
+    /// </summary>
+    static const size_t CommunityThreshold = 5000;
+    /// <summary>
+    /// weight of a speculative center solve relative to the final one
+    /// </summary>
+    static constexpr double SpeculationWeight = 0.25;
 public:
     virtual Solution SolveExt(const Problem& problem, OptionalTimeLimitMs timeLimit) override;
 private:
     virtual std::vector<Partition> ConvertClauses(std::vector<Clause>& clauses);
-    virtual void MergePartitions(std::vector<Partition>& partitions, size_t& into, size_t& from);
-    virtual void DeletePartition(std::vector<Partition>& partitions, size_t& position);
-    virtual void MergePartitionsC2(std::vector<Partition>& partitions);
-    virtual std::vector<Clause> MergeClauses1(std::vector<Partition>& partitions);
-    virtual void MergeConnections(std::vector<Partition>& partitions);
+    /// <summary>
+    /// one partition per community of the variable incidence graph
+    /// </summary>
+    /// <param name="numberOfVariables"></param>
+    /// <param name="clauses">moved into the partitions</param>
+    /// <returns></returns>
+    virtual std::vector<Partition> ConvertCommunities(Variable numberOfVariables, std::vector<Clause>& clauses);
+    /// <summary>
+    /// Merges the partitions along their shared variables (see PartitionGraph).
+    /// </summary>
+    /// <param name="numberOfVariables"></param>
+    /// <param name="partitions">moved into the graph, afterwards the merged partitions</param>
+    /// <returns>loose clauses, they share no variable with any other clause</returns>
+    virtual std::vector<Clause> MergePartitions(Variable numberOfVariables, std::vector<Partition>& partitions);
+    /// <summary>
+    /// Enumerates the extendable rows of the truth tables of all satellite partitions in parallel,
+    /// one job per partition (see EnumerateSubproblemProjections).
+    /// Stops early if a partition has no extendable row or if the center problem
+    /// is decided by the blocking clauses known so far: it is unsatisfiable,
+    /// or a model of it selects rows that the unfinished partitions extend.
+    /// The partition solver must be thread safe.
+    /// </summary>
+    /// <param name="problem"></param>
+    /// <param name="partitions"></param>
+    /// <returns></returns>
     virtual Solution SolveSubproblems(const Problem& problem, std::vector<Partition>& partitions);
-    virtual std::vector<Problem> CreateSubProblems(const Problem& problem, const Partition& partition, const std::set<Variable>& subCutSet, const std::vector<PartialAssignment>& truthTable);
+    /// <summary>
+    /// row of the truth table (see CreateTruthTable) that is compatible with the assignment
+    /// </summary>
+    /// <param name="subCutSet"></param>
+    /// <param name="assignment"></param>
+    /// <returns></returns>
+    static size_t GetRow(const std::set<Variable>& subCutSet, const Assignment& assignment);
     virtual Problem CreateCenterProblem(const Problem& problem, const Partition& centerPartition, const std::vector<std::set<Variable>>& subCutSet, const std::vector<std::vector<PartialAssignment>>& truthTable, const std::vector<std::vector<Solution>>& partitionSolutions);
     virtual Solution CompleteAssignment(const Solution& solution, std::vector<Partition>& partitions, const std::vector<std::vector<PartialAssignment>>& truthTable, const std::vector<std::vector<Solution>>& partitionSolutions);
-    /// <summary>
-/// unused
-/// </summary>
-/// <param name="partitions"></param>
-/// <returns></returns>
-    virtual std::vector<Partition> ExtractConnections(std::vector<Partition>& partitions);
     virtual std::set<Literal> FindCutSet(const std::vector<Partition>& partitions);
     /// <summary>
     /// unused
@@ -0,0 +1,251 @@
+#include "Partitioning/stdafx.h"
+#include "TreeDecompositionPartitioner.h"
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <stdexcept>
+
+#include "Core/Utility/CompactedProblem.h"
+#include "Core/Utility/RestrictionEngine.h"
+#include "Core/Utility/StatsCollector.h"
+#include "Core/Utility/TaskScheduler.h"
+#include "Core/Utility/Trace.h"
+
+namespace {
+
+/// <summary>
+/// Results of one bag for every assignment of its separator (row i: bit j is the value of separator variable j).
+/// </summary>
+struct BagTable {
+    std::vector<Variable> separator;
+    /// <summary>
+    /// original variable of each variable of the bag problem (index 0 unused)
+    /// </summary>
+    std::vector<Variable> variables;
+    /// <summary>
+    /// values of the bag problem variables per row, none if the row can not be extended
+    /// </summary>
+    std::vector<std::optional<std::vector<VariableState>>> extensions;
+};
+
+/// <summary>
+/// Bag problem in the local numbering of a CompactedProblem.
+/// </summary>
+struct BagProblem {
+    CompactedProblem compacted;
+    RestrictionEngine engine;
+    /// <summary>
+    /// local variable of each separator variable, 0 if it does not occur in the bag problem
+    /// </summary>
+    std::vector<Variable> separator;
+
+    BagProblem(Variable numberOfVariables, std::vector<Clause>&& clauses) :
+        compacted(numberOfVariables, std::move(clauses)),
+        engine(compacted.GetProblem().GetClauses())
+    {
+    }
+};
+
+/// <summary>
+/// forbids one row of the separator
+/// </summary>
+Clause CreateBlockingClause(const std::vector<Variable>& separator, size_t row)
+{
+    Clause clause;
+    for (size_t i = 0; i < separator.size(); i++) {
+        clause.push_back((row >> i) & 1 ? Negate(separator[i]) : separator[i]);
+    }
+    return clause;
+}
+
+}
+
+TreeDecompositionPartitioner::TreeDecompositionPartitioner(EliminationHeuristic heuristic, size_t maxSeparatorSize) :
+    heuristic(heuristic),
+    maxSeparatorSize(maxSeparatorSize)
+{
+    if (maxSeparatorSize >= 8 * sizeof(size_t)) {
+        throw std::invalid_argument("separator too large to enumerate");
+    }
+}
+
+Solution TreeDecompositionPartitioner::SolveExt(const Problem& problem, OptionalTimeLimitMs)
+{
+    auto decomposition = Decompose(problem);
+    if (!decomposition || decomposition->GetNumberOfBags() <= 1) {
+        // no useful decomposition
+        return partitionSolver->Solve(problem, GetRemainingTimeLimit());
+    }
+    const auto& bags = decomposition.value();
+    auto numberOfBags = bags.GetNumberOfBags();
+
+    // every bag is solved once per row of its separator
+    std::vector<PartitionCost> costs;
+    size_t cutSize = 0;
+    for (size_t bag = 0; bag < numberOfBags; bag++) {
+        std::vector<Clause> clauses;
+        for (auto index : bags.clauses[bag]) {
+            clauses.push_back(problem.GetClauses()[index]);
+        }
+        auto separatorSize = bags.GetSeparator(bag).size();
+        costs.push_back({CostModel::GetFeatures(clauses), std::pow(2.0, static_cast<double>(separatorSize))});
+        cutSize += separatorSize;
+    }
+    if (!IsCheaperPartitioned(CostModel::GetFeatures(problem), costs).value_or(true)) {
+        return partitionSolver->Solve(problem, GetRemainingTimeLimit());
+    }
+    StatsCollector::AddCutSize(cutSize);
+
+    // bags of the same height only depend on lower bags
+    std::vector<std::vector<size_t>> children(numberOfBags);
+    std::vector<size_t> heights(numberOfBags, 0);
+    for (size_t bag = 0; bag < numberOfBags; bag++) {
+        if (bags.parents[bag] != TreeDecomposition::None) {
+            children[bags.parents[bag]].push_back(bag);
+            heights[bags.parents[bag]] = std::max(heights[bags.parents[bag]], heights[bag] + 1);
+        }
+    }
+    std::vector<std::vector<size_t>> levels(*std::max_element(heights.begin(), heights.end()) + 1);
+    for (size_t bag = 0; bag < numberOfBags; bag++) {
+        levels[heights[bag]].push_back(bag);
+    }
+
+    std::vector<BagTable> tables(numberOfBags);
+    std::mutex mutex;
+    std::optional<SolvingResult> decided;
+    for (const auto& level : levels) {
+        CheckTimeLimit();
+
+        std::vector<std::unique_ptr<BagProblem>> bagProblems(numberOfBags);
+        std::vector<size_t> unsatisfiableRows(numberOfBags, 0);
+        TaskGroup group;
+        for (auto bag : level) {
+            group.Run([&, bag]() {
+                CheckTimeLimit();
+
+                // own clauses and the separator rows of the children that can not be extended
+                std::vector<Clause> clauses;
+                for (auto index : bags.clauses[bag]) {
+                    clauses.push_back(problem.GetClauses()[index]);
+                }
+                for (auto child : children[bag]) {
+                    const auto& table = tables[child];
+                    for (size_t row = 0; row < table.extensions.size(); row++) {
+                        if (!table.extensions[row]) {
+                            clauses.push_back(CreateBlockingClause(table.separator, row));
+                        }
+                    }
+                }
+                auto bagProblem = std::make_unique<BagProblem>(problem.GetNumberOfVariables(), std::move(clauses));
+                const auto& localProblem = bagProblem->compacted.GetProblem();
+
+                auto& table = tables[bag];
+                table.separator = bags.GetSeparator(bag);
+                table.variables.assign(static_cast<size_t>(localProblem.GetNumberOfVariables()) + 1, 0);
+                std::vector<std::pair<Variable, Variable>> locals;
+                for (auto variable = FirstVariable; variable <= localProblem.GetNumberOfVariables(); variable++) {
+                    table.variables[variable] = bagProblem->compacted.GetOriginalVariable(variable);
+                    locals.emplace_back(table.variables[variable], variable);
+                }
+                for (auto variable : table.separator) {
+                    auto local = std::lower_bound(locals.begin(), locals.end(), std::make_pair(variable, 0));
+                    bagProblem->separator.push_back(local != locals.end() && local->first == variable ? local->second : 0);
+                }
+                table.extensions.resize(size_t(1) << table.separator.size());
+                bagProblems[bag] = std::move(bagProblem);
+
+                for (size_t row = 0; row < table.extensions.size(); row++) {
+                    group.Run([&, bag, row]() {
+                        CheckTimeLimit();
+                        const auto& bagProblem = *bagProblems[bag];
+                        const auto& localProblem = bagProblem.compacted.GetProblem();
+                        Assignment cube(localProblem.GetNumberOfVariables());
+                        for (size_t i = 0; i < bagProblem.separator.size(); i++) {
+                            if (bagProblem.separator[i] != 0) {
+                                cube.SetState(bagProblem.separator[i], (row >> i) & 1 ? VariableState::True : VariableState::False);
+                            }
+                        }
+
+                        auto solution = SolvePartition(localProblem, bagProblem.engine, cube);
+                        std::lock_guard<std::mutex> lock(mutex);
+                        auto& table = tables[bag];
+                        if (solution.first == SolvingResult::Undefined) {
+                            decided = SolvingResult::Undefined;
+                            group.Cancel();
+                            return;
+                        }
+                        if (solution.first == SolvingResult::Unsatisfiable) {
+                            if (++unsatisfiableRows[bag] == table.extensions.size()) {
+                                // the subtree can not be satisfied at all
+                                decided = SolvingResult::Unsatisfiable;
+                                group.Cancel();
+                            }
+                            return;
+                        }
+                        std::vector<VariableState> values(localProblem.GetNumberOfVariables() + 1, VariableState::Undefined);
+                        for (auto variable = FirstVariable; variable <= localProblem.GetNumberOfVariables(); variable++) {
+                            auto state = cube.GetState(variable);
+                            values[variable] = state != VariableState::Undefined ? state : solution.second.value().GetState(variable);
+                        }
+                        table.extensions[row] = std::move(values);
+                    });
+                }
+            });
+        }
+        group.Wait();
+
+        if (decided) {
+            return {decided.value(), {}};
+        }
+    }
+
+    // top-down: the parent fixes the separator, which selects the row of the bag
+    Assignment assignment(problem.GetNumberOfVariables(), VariableState::False);
+    for (auto bag = numberOfBags; bag-- > 0;) {
+        CheckTimeLimit();
+        const auto& table = tables[bag];
+        size_t row = 0;
+        for (size_t i = 0; i < table.separator.size(); i++) {
+            if (assignment.GetState(table.separator[i]) == VariableState::True) {
+                row |= size_t(1) << i;
+            }
+        }
+        if (!table.extensions[row]) {
+            throw std::runtime_error("separator assignment of the parent can not be extended");
+        }
+        const auto& values = table.extensions[row].value();
+        for (size_t variable = FirstVariable; variable < values.size(); variable++) {
+            if (values[variable] != VariableState::Undefined) {
+                assignment.SetState(table.variables[variable], values[variable]);
+            }
+        }
+    }
+
+    return {problem.Apply(assignment), assignment};
+}
+
+std::vector<std::set<Variable>> TreeDecompositionPartitioner::CreatePartitions(const Problem& problem)
+{
+    std::vector<std::set<Variable>> partitions;
+    if (auto decomposition = Decompose(problem)) {
+        for (const auto& bag : decomposition->bags) {
+            partitions.emplace_back(bag.begin(), bag.end());
+        }
+    }
+    return partitions;
+}
+
+bool TreeDecompositionPartitioner::IsGoodPartitioning(const std::vector<Problem>&, const std::vector<std::set<Variable>>&, const std::set<Variable>&)
+{
+    // SolveExt does not use the cube enumeration
+    return false;
+}
+
+std::optional<TreeDecomposition> TreeDecompositionPartitioner::Decompose(const Problem& problem)
+{
+    TraceSpan span("Decompose", "partitioning");
+    return DecomposeTree(problem, heuristic, maxSeparatorSize, MinClausesPerBag, [this]() {
+        CheckTimeLimit();
+    });
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Partitioning/DLLMakro.h"
+
+#include "AbstractPartitioner.h"
+#include "Partitioning/Utility/TreeDecomposition.h"
+
+#include <set>
+#include <vector>
+
+/// <summary>
+/// Class to solve a problem along a tree decomposition of its primal graph.
+/// Bottom-up, every bag is solved with the partition solver for each assignment of its separator,
+/// the separator assignments that can not be extended are forbidden in the parent bag.
+/// Afterwards the model is rebuilt top-down, so the work grows with 2^width instead of the whole formula.
+/// The partition solver must be thread safe.
+/// </summary>
+class PARTITIONINING_API TreeDecompositionPartitioner : public AbstractPartitioner {
+private:
+    /// <summary>
+    /// smaller bags are merged into their parents, a bag costs up to 2^separator solver calls
+    /// </summary>
+    static const size_t MinClausesPerBag = 64;
+
+private:
+    EliminationHeuristic heuristic;
+    size_t maxSeparatorSize;
+
+public:
+    /// <summary>
+    ///
+    /// </summary>
+    /// <param name="heuristic">elimination order of the decomposition</param>
+    /// <param name="maxSeparatorSize">width bound, problems with wider decompositions are solved directly</param>
+    TreeDecompositionPartitioner(EliminationHeuristic heuristic = EliminationHeuristic::MinFill, size_t maxSeparatorSize = 10);
+
+public:
+    virtual Solution SolveExt(const Problem& problem, OptionalTimeLimitMs timeLimit) override;
+
+protected:
+    virtual std::vector<std::set<Variable>> CreatePartitions(const Problem& problem) override;
+    virtual bool IsGoodPartitioning(const std::vector<Problem>& problems, const std::vector<std::set<Variable>>& partitions, const std::set<Variable>& cutSet) override;
+
+private:
+    virtual std::optional<TreeDecomposition> Decompose(const Problem& problem);
+};
@@ -0,0 +1,166 @@
+#include "Partitioning/stdafx.h"
+#include "ClauseRouter.h"
+
+#include <algorithm>
+#include <atomic>
+
+#include "Core/Utility/TaskScheduler.h"
+
+namespace {
+
+/// <summary>
+/// Below this number of clauses per task the threads cost more than they save.
+/// </summary>
+constexpr size_t MinClausesPerTask = 1 << 14;
+/// <summary>
+/// target of clauses that are satisfied by the assignment
+/// </summary>
+constexpr size_t Dropped = ClauseRouter::None - 2;
+
+}
+
+std::vector<Clause> PartitionClauses::ToClauses() const
+{
+    std::vector<Clause> clauses;
+    clauses.reserve(GetNumberOfClauses());
+    for (size_t i = 0; i < GetNumberOfClauses(); i++) {
+        clauses.emplace_back(literals.begin() + offsets[i], literals.begin() + offsets[i + 1]);
+    }
+    return clauses;
+}
+
+ClauseRouter::ClauseRouter(Variable numberOfVariables, const std::vector<std::set<Variable>>& partitions, const std::set<Variable>& cutSet) :
+    owner(static_cast<size_t>(numberOfVariables) + 1, None),
+    numberOfPartitions(partitions.size())
+{
+    for (size_t i = 0; i < partitions.size(); i++) {
+        for (auto variable : partitions[i]) {
+            owner[variable] = cutSet.find(variable) != cutSet.end() ? Cut : i;
+        }
+    }
+}
+
+size_t ClauseRouter::GetOwner(Variable variable) const
+{
+    return owner[variable];
+}
+
+std::optional<std::vector<PartitionClauses>> ClauseRouter::Route(const Problem& problem, const Assignment& assignment, const std::function<size_t(const Clause&)>& routeCutClause) const
+{
+    if (numberOfPartitions == 0) {
+        return {};
+    }
+
+    const auto& clauses = problem.GetClauses();
+    auto numberOfThreads = std::max<size_t>(1, TaskScheduler::GetShared().GetNumberOfThreads());
+    auto numberOfTasks = std::max<size_t>(1, std::min(numberOfThreads, clauses.size() / MinClausesPerTask));
+    auto chunkSize = (clauses.size() + numberOfTasks - 1) / numberOfTasks;
+
+    auto forEachChunk = [&](const std::function<void(size_t, size_t, size_t)>& work) {
+        if (numberOfTasks == 1) {
+            work(0, 0, clauses.size());
+            return;
+        }
+        TaskGroup group;
+        for (size_t task = 0; task < numberOfTasks; task++) {
+            auto first = std::min(clauses.size(), task * chunkSize);
+            auto last = std::min(clauses.size(), first + chunkSize);
+            group.Run([&work, task, first, last]() {
+                work(task, first, last);
+            });
+        }
+        group.Wait();
+    };
+
+    // first pass: target of each clause and size of each partition per task
+    std::vector<size_t> targets(clauses.size());
+    std::vector<std::vector<size_t>> clauseCounts(numberOfTasks, std::vector<size_t>(numberOfPartitions, 0));
+    std::vector<std::vector<size_t>> literalCounts(numberOfTasks, std::vector<size_t>(numberOfPartitions, 0));
+    std::atomic<bool> invalid(false);
+    forEachChunk([&](size_t task, size_t first, size_t last) {
+        for (auto i = first; i < last && !invalid; i++) {
+            const auto& clause = clauses[i];
+            if (std::any_of(clause.begin(), clause.end(), [&assignment](auto literal) {
+                return assignment.IsSAT(literal);
+            })) {
+                targets[i] = Dropped;
+                continue;
+            }
+
+            auto target = None;
+            size_t length = 0;
+            for (auto literal : clause) {
+                auto variableOwner = owner[ToVariable(literal)];
+                if (variableOwner == None || (variableOwner != Cut && target != None && target != variableOwner)) {
+                    // variable is in no partition or in another partition than the rest of the clause
+                    invalid = true;
+                    break;
+                }
+                if (variableOwner != Cut) {
+                    target = variableOwner;
+                }
+                if (!assignment.IsSAT(Negate(literal))) {
+                    length++;
+                }
+            }
+            if (target == None && !clause.empty()) {
+                target = routeCutClause(clause);
+                if (target == None) {
+                    invalid = true;
+                }
+            }
+            if (clause.empty()) {
+                target = 0;
+            }
+            targets[i] = target;
+            if (target < numberOfPartitions) {
+                clauseCounts[task][target]++;
+                literalCounts[task][target] += length;
+            }
+        }
+    });
+    if (invalid) {
+        return {};
+    }
+
+    // prefix sums: first clause and literal of each task within each partition
+    std::vector<PartitionClauses> result(numberOfPartitions);
+    for (size_t partition = 0; partition < numberOfPartitions; partition++) {
+        size_t clauseSum = 0;
+        size_t literalSum = 0;
+        for (size_t task = 0; task < numberOfTasks; task++) {
+            auto numberOfClauses = clauseCounts[task][partition];
+            auto numberOfLiterals = literalCounts[task][partition];
+            clauseCounts[task][partition] = clauseSum;
+            literalCounts[task][partition] = literalSum;
+            clauseSum += numberOfClauses;
+            literalSum += numberOfLiterals;
+        }
+        result[partition].offsets.assign(clauseSum + 1, 0);
+        result[partition].literals.resize(literalSum);
+        result[partition].indices.resize(clauseSum);
+    }
+
+    // second pass: fill the partitions in place
+    forEachChunk([&](size_t task, size_t first, size_t last) {
+        auto& clausePositions = clauseCounts[task];
+        auto& literalPositions = literalCounts[task];
+        for (auto i = first; i < last; i++) {
+            if (targets[i] == Dropped) {
+                continue;
+            }
+            auto& partition = result[targets[i]];
+            auto& literalPosition = literalPositions[targets[i]];
+            for (auto literal : clauses[i]) {
+                if (!assignment.IsSAT(Negate(literal))) {
+                    partition.literals[literalPosition++] = literal;
+                }
+            }
+            auto clausePosition = clausePositions[targets[i]]++;
+            partition.indices[clausePosition] = i;
+            partition.offsets[clausePosition + 1] = literalPosition;
+        }
+    });
+
+    return result;
+}
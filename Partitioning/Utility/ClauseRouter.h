@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Partitioning/DLLMakro.h"
+
+#include <functional>
+#include <limits>
+#include <optional>
+#include <set>
+#include <vector>
+
+#include "Core/Types/Problem.h"
+
+/// <summary>
+/// Clauses of one partition, stored in one contiguous block of literals.
+/// </summary>
+struct PARTITIONINING_API PartitionClauses {
+    /// <summary>
+    /// literals of clause i are literals[offsets[i]] .. literals[offsets[i + 1] - 1]
+    /// </summary>
+    std::vector<size_t> offsets = {0};
+    std::vector<Literal> literals;
+    /// <summary>
+    /// index of each clause in the routed problem
+    /// </summary>
+    std::vector<size_t> indices;
+
+    size_t GetNumberOfClauses() const
+    {
+        return indices.size();
+    }
+
+    std::vector<Clause> ToClauses() const;
+};
+
+/// <summary>
+/// Sends every clause to the partition that contains its variables.
+/// The partition of each variable is looked up in an array, which is built once.
+/// </summary>
+class PARTITIONINING_API ClauseRouter {
+public:
+    static constexpr size_t None = std::numeric_limits<size_t>::max();
+    static constexpr size_t Cut = None - 1;
+
+private:
+    std::vector<size_t> owner;
+    size_t numberOfPartitions;
+
+public:
+    ClauseRouter(Variable numberOfVariables, const std::vector<std::set<Variable>>& partitions, const std::set<Variable>& cutSet);
+
+public:
+    /// <summary>
+    /// partition of the variable, Cut for variables of the cut set, None if it is in no partition
+    /// </summary>
+    /// <param name="variable"></param>
+    /// <returns></returns>
+    size_t GetOwner(Variable variable) const;
+
+    /// <summary>
+    /// Routes the clauses simplified by the assignment in one parallel pass.
+    /// The literals are counted first, so the partitions are allocated once and filled in place.
+    /// </summary>
+    /// <param name="problem"></param>
+    /// <param name="assignment">satisfied clauses are dropped, falsified literals are removed</param>
+    /// <param name="routeCutClause">partition of a clause that only has cut variables (None: no partition fits)</param>
+    /// <returns>none if a clause does not fit into any partition</returns>
+    std::optional<std::vector<PartitionClauses>> Route(const Problem& problem, const Assignment& assignment, const std::function<size_t(const Clause&)>& routeCutClause) const;
+};
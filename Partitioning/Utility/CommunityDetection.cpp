@@ -0,0 +1,456 @@
+#include "Partitioning/stdafx.h"
+#include "CommunityDetection.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <tuple>
+
+#include "Core/Utility/TaskScheduler.h"
+
+namespace {
+
+/// <summary>
+/// clauses with more variables are connected as a path
+/// </summary>
+const size_t MaxCliqueSize = 32;
+const size_t MaxRounds = 32;
+const size_t MaxLevels = 32;
+const size_t MaxShrinkPasses = 4;
+/// <summary>
+/// smaller modularity gains are treated as noise
+/// </summary>
+const double MinGain = 1e-12;
+const size_t MinVerticesPerTask = 1024;
+
+using Edge = std::tuple<size_t, size_t, double>;
+
+/// <summary>
+/// Sorts the edges and merges parallel ones into the csr format.
+/// </summary>
+WeightedGraph CreateGraph(size_t numberOfVertices, std::vector<Edge>& edges, std::vector<double>&& selfLoops)
+{
+    std::sort(edges.begin(), edges.end(), [](const auto& l, const auto& r) {
+        return std::tie(std::get<0>(l), std::get<1>(l)) < std::tie(std::get<0>(r), std::get<1>(r));
+    });
+
+    WeightedGraph graph;
+    graph.offsets.assign(numberOfVertices + 1, 0);
+    for (size_t i = 0; i < edges.size(); i++) {
+        auto [u, v, w] = edges[i];
+        if (!graph.neighbors.empty() && i > 0 && std::get<0>(edges[i - 1]) == u && std::get<1>(edges[i - 1]) == v) {
+            graph.weights.back() += w;
+            continue;
+        }
+        graph.neighbors.push_back(v);
+        graph.weights.push_back(w);
+        graph.offsets[u + 1]++;
+    }
+    std::partial_sum(graph.offsets.begin(), graph.offsets.end(), graph.offsets.begin());
+    graph.selfLoops = std::move(selfLoops);
+    return graph;
+}
+
+/// <summary>
+/// sum of the weights of all edges at v, edges within v count twice
+/// </summary>
+double GetDegree(const WeightedGraph& graph, size_t v)
+{
+    auto degree = 2.0 * graph.selfLoops[v];
+    for (auto i = graph.offsets[v]; i < graph.offsets[v + 1]; i++) {
+        degree += graph.weights[i];
+    }
+    return degree;
+}
+
+class Louvain {
+private:
+    const WeightedGraph& graph;
+    const std::function<void()>& checkTimeLimit;
+    std::vector<double> degrees;
+    std::vector<double> totals;
+    std::vector<size_t> communities;
+    double totalWeight = 0.0;
+
+public:
+    Louvain(const WeightedGraph& graph, const std::function<void()>& checkTimeLimit) :
+        graph(graph),
+        checkTimeLimit(checkTimeLimit)
+    {
+        auto n = graph.GetNumberOfVertices();
+        degrees.resize(n);
+        for (size_t v = 0; v < n; v++) {
+            degrees[v] = GetDegree(graph, v);
+        }
+        totals = degrees;
+        communities.resize(n);
+        std::iota(communities.begin(), communities.end(), 0);
+        totalWeight = std::accumulate(degrees.begin(), degrees.end(), 0.0);
+    }
+
+    /// <summary>
+    /// local moving phase
+    /// </summary>
+    /// <returns>true if at least one vertex changed its community</returns>
+    bool MoveVertices()
+    {
+        if (totalWeight <= 0.0) {
+            return false;
+        }
+
+        auto n = graph.GetNumberOfVertices();
+        std::vector<size_t> proposals(n);
+        bool moved = false;
+        for (size_t round = 0; round < MaxRounds; round++) {
+            checkTimeLimit();
+            Propose(proposals);
+
+            size_t moves = 0;
+            for (size_t v = 0; v < n; v++) {
+                if (proposals[v] != communities[v] && GetGain(v, proposals[v]) > MinGain) {
+                    totals[communities[v]] -= degrees[v];
+                    totals[proposals[v]] += degrees[v];
+                    communities[v] = proposals[v];
+                    moves++;
+                }
+            }
+            if (moves == 0) {
+                break;
+            }
+            moved = true;
+        }
+        return moved;
+    }
+
+    /// <summary>
+    /// renumbers the communities from 0
+    /// </summary>
+    /// <returns>number of communities</returns>
+    size_t Compact()
+    {
+        std::vector<size_t> newId(communities.size(), std::numeric_limits<size_t>::max());
+        size_t count = 0;
+        for (auto& community : communities) {
+            if (newId[community] == std::numeric_limits<size_t>::max()) {
+                newId[community] = count++;
+            }
+            community = newId[community];
+        }
+        return count;
+    }
+
+    const std::vector<size_t>& GetCommunities() const
+    {
+        return communities;
+    }
+
+    /// <summary>
+    /// graph with one vertex per community
+    /// </summary>
+    WeightedGraph Aggregate(size_t numberOfCommunities) const
+    {
+        std::vector<double> selfLoops(numberOfCommunities, 0.0);
+        std::vector<Edge> edges;
+        for (size_t v = 0; v < graph.GetNumberOfVertices(); v++) {
+            auto cv = communities[v];
+            selfLoops[cv] += graph.selfLoops[v];
+            for (auto i = graph.offsets[v]; i < graph.offsets[v + 1]; i++) {
+                auto cu = communities[graph.neighbors[i]];
+                if (cu == cv) {
+                    // seen from both ends
+                    selfLoops[cv] += graph.weights[i] / 2.0;
+                } else {
+                    edges.emplace_back(cv, cu, graph.weights[i]);
+                }
+            }
+        }
+        return CreateGraph(numberOfCommunities, edges, std::move(selfLoops));
+    }
+
+private:
+    /// <summary>
+    /// weights from v to its current community and to target
+    /// </summary>
+    std::pair<double, double> GetWeights(size_t v, size_t target) const
+    {
+        double toCurrent = 0.0;
+        double toTarget = 0.0;
+        for (auto i = graph.offsets[v]; i < graph.offsets[v + 1]; i++) {
+            auto u = graph.neighbors[i];
+            if (u == v) {
+                continue;
+            }
+            if (communities[u] == communities[v]) {
+                toCurrent += graph.weights[i];
+            }
+            if (communities[u] == target) {
+                toTarget += graph.weights[i];
+            }
+        }
+        return {toCurrent, toTarget};
+    }
+
+    /// <summary>
+    /// modularity gain (times total weight) of moving v to target
+    /// </summary>
+    double GetGain(size_t v, size_t target) const
+    {
+        auto [toCurrent, toTarget] = GetWeights(v, target);
+        auto current = communities[v];
+        auto scale = degrees[v] / totalWeight;
+        return (toTarget - totals[target] * scale) - (toCurrent - (totals[current] - degrees[v]) * scale);
+    }
+
+    /// <summary>
+    /// best community of every vertex with respect to the current state, evaluated in parallel
+    /// </summary>
+    void Propose(std::vector<size_t>& proposals) const
+    {
+        auto n = graph.GetNumberOfVertices();
+        auto& scheduler = TaskScheduler::GetShared();
+        auto chunkSize = std::max(MinVerticesPerTask, n / (4 * std::max<size_t>(1, scheduler.GetNumberOfThreads())) + 1);
+
+        TaskGroup group(scheduler);
+        for (size_t first = 0; first < n; first += chunkSize) {
+            auto last = std::min(n, first + chunkSize);
+            group.Run([this, first, last, &proposals]() {
+                std::vector<std::pair<size_t, double>> candidates;
+                for (auto v = first; v < last; v++) {
+                    candidates.clear();
+                    for (auto i = graph.offsets[v]; i < graph.offsets[v + 1]; i++) {
+                        if (graph.neighbors[i] != v) {
+                            candidates.emplace_back(communities[graph.neighbors[i]], graph.weights[i]);
+                        }
+                    }
+                    std::sort(candidates.begin(), candidates.end());
+
+                    auto current = communities[v];
+                    auto scale = degrees[v] / totalWeight;
+                    double toCurrent = 0.0;
+                    for (const auto& [community, weight] : candidates) {
+                        if (community == current) {
+                            toCurrent += weight;
+                        }
+                    }
+                    auto best = current;
+                    auto bestGain = 0.0;
+                    for (size_t i = 0; i < candidates.size();) {
+                        auto community = candidates[i].first;
+                        double weight = 0.0;
+                        for (; i < candidates.size() && candidates[i].first == community; i++) {
+                            weight += candidates[i].second;
+                        }
+                        if (community == current) {
+                            continue;
+                        }
+                        auto gain = (weight - totals[community] * scale) - (toCurrent - (totals[current] - degrees[v]) * scale);
+                        if (gain > bestGain) {
+                            best = community;
+                            bestGain = gain;
+                        }
+                    }
+                    proposals[v] = best;
+                }
+            });
+        }
+        group.Wait();
+    }
+};
+
+}
+
+WeightedGraph CreateVariableIncidenceGraph(Variable numberOfVariables, const std::vector<Clause>& clauses)
+{
+    std::vector<Edge> edges;
+    std::vector<size_t> variables;
+    for (const auto& clause : clauses) {
+        variables.clear();
+        for (auto literal : clause) {
+            variables.push_back(static_cast<size_t>(ToVariable(literal)) - 1);
+        }
+        std::sort(variables.begin(), variables.end());
+        variables.erase(std::unique(variables.begin(), variables.end()), variables.end());
+        if (variables.size() < 2) {
+            continue;
+        }
+
+        auto weight = 1.0 / (variables.size() - 1);
+        if (variables.size() <= MaxCliqueSize) {
+            for (size_t i = 0; i < variables.size(); i++) {
+                for (size_t j = i + 1; j < variables.size(); j++) {
+                    edges.emplace_back(variables[i], variables[j], weight);
+                    edges.emplace_back(variables[j], variables[i], weight);
+                }
+            }
+        } else {
+            for (size_t i = 1; i < variables.size(); i++) {
+                edges.emplace_back(variables[i - 1], variables[i], 1.0);
+                edges.emplace_back(variables[i], variables[i - 1], 1.0);
+            }
+        }
+    }
+    auto n = static_cast<size_t>(numberOfVariables);
+    return CreateGraph(n, edges, std::vector<double>(n, 0.0));
+}
+
+std::vector<size_t> FindCommunities(const WeightedGraph& graph, const std::function<void()>& checkTimeLimit)
+{
+    // community of every original vertex
+    std::vector<size_t> result(graph.GetNumberOfVertices());
+    std::iota(result.begin(), result.end(), 0);
+
+    WeightedGraph current = graph;
+    for (size_t level = 0; level < MaxLevels; level++) {
+        Louvain louvain(current, checkTimeLimit);
+        if (!louvain.MoveVertices()) {
+            break;
+        }
+        auto numberOfCommunities = louvain.Compact();
+        const auto& communities = louvain.GetCommunities();
+        for (auto& community : result) {
+            community = communities[community];
+        }
+        if (numberOfCommunities == current.GetNumberOfVertices()) {
+            break;
+        }
+        current = louvain.Aggregate(numberOfCommunities);
+    }
+    return result;
+}
+
+std::vector<size_t> AssignClausesToCommunities(const std::vector<Clause>& clauses, const std::vector<size_t>& communities)
+{
+    std::vector<size_t> blocks(clauses.size(), 0);
+    std::vector<size_t> candidates;
+    for (size_t i = 0; i < clauses.size(); i++) {
+        candidates.clear();
+        for (auto literal : clauses[i]) {
+            candidates.push_back(communities[ToVariable(literal) - 1]);
+        }
+        std::sort(candidates.begin(), candidates.end());
+
+        // most frequent, ties go to the smaller community id
+        size_t bestCount = 0;
+        for (size_t j = 0; j < candidates.size();) {
+            auto k = j;
+            while (k < candidates.size() && candidates[k] == candidates[j]) {
+                k++;
+            }
+            if (k - j > bestCount) {
+                bestCount = k - j;
+                blocks[i] = candidates[j];
+            }
+            j = k;
+        }
+    }
+    return blocks;
+}
+
+void ShrinkBoundary(const std::vector<Clause>& clauses, std::vector<size_t>& blocks, size_t numberOfBlocks, double imbalance, const std::function<void()>& checkTimeLimit)
+{
+    // distinct variables of each clause
+    std::vector<std::vector<Variable>> variables(clauses.size());
+    Variable maxVariable = 0;
+    for (size_t i = 0; i < clauses.size(); i++) {
+        for (auto literal : clauses[i]) {
+            variables[i].push_back(ToVariable(literal));
+        }
+        std::sort(variables[i].begin(), variables[i].end());
+        variables[i].erase(std::unique(variables[i].begin(), variables[i].end()), variables[i].end());
+        if (!variables[i].empty()) {
+            maxVariable = std::max(maxVariable, variables[i].back());
+        }
+    }
+
+    // number of clauses of every block a variable occurs in
+    std::vector<std::vector<std::pair<size_t, size_t>>> occurrences(static_cast<size_t>(maxVariable) + 1);
+    auto find = [&occurrences](Variable variable, size_t block) {
+        auto& list = occurrences[variable];
+        return std::find_if(list.begin(), list.end(), [block](const auto& entry) {
+            return entry.first == block;
+        });
+    };
+    auto count = [&](Variable variable, size_t block) -> size_t {
+        auto it = find(variable, block);
+        return it == occurrences[variable].end() ? 0 : it->second;
+    };
+
+    std::vector<size_t> sizes(numberOfBlocks, 0);
+    for (size_t i = 0; i < clauses.size(); i++) {
+        sizes[blocks[i]]++;
+        for (auto variable : variables[i]) {
+            auto it = find(variable, blocks[i]);
+            if (it == occurrences[variable].end()) {
+                occurrences[variable].emplace_back(blocks[i], 1);
+            } else {
+                it->second++;
+            }
+        }
+    }
+    std::vector<size_t> maxSizes(numberOfBlocks);
+    for (size_t block = 0; block < numberOfBlocks; block++) {
+        maxSizes[block] = static_cast<size_t>((1.0 + imbalance) * sizes[block]) + 1;
+    }
+
+    std::vector<size_t> targets;
+    for (size_t pass = 0; pass < MaxShrinkPasses; pass++) {
+        checkTimeLimit();
+        size_t moves = 0;
+        for (size_t i = 0; i < clauses.size(); i++) {
+            auto from = blocks[i];
+
+            targets.clear();
+            for (auto variable : variables[i]) {
+                for (const auto& entry : occurrences[variable]) {
+                    if (entry.first != from) {
+                        targets.push_back(entry.first);
+                    }
+                }
+            }
+            std::sort(targets.begin(), targets.end());
+            targets.erase(std::unique(targets.begin(), targets.end()), targets.end());
+
+            // change of the number of cut variables
+            long long bestDelta = 0;
+            auto best = from;
+            for (auto to : targets) {
+                if (sizes[to] + 1 > maxSizes[to]) {
+                    continue;
+                }
+                long long delta = 0;
+                for (auto variable : variables[i]) {
+                    auto before = occurrences[variable].size();
+                    auto after = before - (count(variable, from) == 1 ? 1 : 0) + (count(variable, to) == 0 ? 1 : 0);
+                    delta += (after >= 2 ? 1 : 0) - (before >= 2 ? 1 : 0);
+                }
+                if (delta < bestDelta || (delta == bestDelta && delta < 0 && sizes[to] < sizes[best])) {
+                    bestDelta = delta;
+                    best = to;
+                }
+            }
+            if (best == from) {
+                continue;
+            }
+
+            for (auto variable : variables[i]) {
+                auto it = find(variable, from);
+                if (--it->second == 0) {
+                    occurrences[variable].erase(it);
+                }
+                it = find(variable, best);
+                if (it == occurrences[variable].end()) {
+                    occurrences[variable].emplace_back(best, 1);
+                } else {
+                    it->second++;
+                }
+            }
+            sizes[from]--;
+            sizes[best]++;
+            blocks[i] = best;
+            moves++;
+        }
+        if (moves == 0) {
+            break;
+        }
+    }
+}
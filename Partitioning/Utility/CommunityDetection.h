@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Partitioning/DLLMakro.h"
+
+#include <functional>
+#include <vector>
+
+#include "Core/Types/Problem.h"
+
+/// <summary>
+/// Undirected weighted graph in compressed sparse row format.
+/// Every edge is stored in both directions.
+/// </summary>
+struct WeightedGraph {
+    /// <summary>
+    /// neighbors of v are neighbors[offsets[v]] .. neighbors[offsets[v + 1] - 1]
+    /// </summary>
+    std::vector<size_t> offsets;
+    std::vector<size_t> neighbors;
+    std::vector<double> weights;
+    /// <summary>
+    /// weight of the edges within an aggregated vertex
+    /// </summary>
+    std::vector<double> selfLoops;
+
+    size_t GetNumberOfVertices() const
+    {
+        return offsets.empty() ? 0 : offsets.size() - 1;
+    }
+};
+
+/// <summary>
+/// Vertex v - 1 is variable v. Two variables are connected if they occur in the same clause,
+/// each clause contributes a total weight of one to every of its variables.
+/// Long clauses are connected as a path instead of a clique to keep the graph small.
+/// </summary>
+/// <param name="numberOfVariables"></param>
+/// <param name="clauses"></param>
+/// <returns></returns>
+PARTITIONINING_API WeightedGraph CreateVariableIncidenceGraph(Variable numberOfVariables, const std::vector<Clause>& clauses);
+
+/// <summary>
+/// Louvain modularity optimization. The moves of each round are evaluated in parallel
+/// and applied sequentially if they still improve the modularity.
+/// </summary>
+/// <param name="graph"></param>
+/// <param name="checkTimeLimit">called regularly, may throw to abort</param>
+/// <returns>community of each vertex, numbered from 0</returns>
+PARTITIONINING_API std::vector<size_t> FindCommunities(const WeightedGraph& graph, const std::function<void()>& checkTimeLimit);
+
+/// <summary>
+/// Assigns every clause to the community of most of its variables.
+/// </summary>
+/// <param name="clauses"></param>
+/// <param name="communities">community of each variable (index variable - 1)</param>
+/// <returns>community of each clause</returns>
+PARTITIONINING_API std::vector<size_t> AssignClausesToCommunities(const std::vector<Clause>& clauses, const std::vector<size_t>& communities);
+
+/// <summary>
+/// Greedily moves clauses to other blocks as long as this reduces the number of variables
+/// that occur in more than one block. A block may grow by the factor (1 + imbalance) at most.
+/// </summary>
+/// <param name="clauses"></param>
+/// <param name="blocks">block of each clause</param>
+/// <param name="numberOfBlocks"></param>
+/// <param name="imbalance"></param>
+/// <param name="checkTimeLimit">called regularly, may throw to abort</param>
+PARTITIONINING_API void ShrinkBoundary(const std::vector<Clause>& clauses, std::vector<size_t>& blocks, size_t numberOfBlocks, double imbalance, const std::function<void()>& checkTimeLimit);
@@ -0,0 +1,672 @@
+#include "Partitioning/stdafx.h"
+#include "Hypergraph.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <queue>
+#include <random>
+#include <stdexcept>
+#include <utility>
+
+Hypergraph::Hypergraph(std::vector<size_t>&& vertexWeights, std::vector<size_t>&& netOffsets, std::vector<size_t>&& pins) :
+    vertexWeights(std::move(vertexWeights)),
+    netOffsets(std::move(netOffsets)),
+    pins(std::move(pins))
+{
+    if (this->netOffsets.empty()) {
+        this->netOffsets.push_back(0);
+    }
+    totalWeight = std::accumulate(this->vertexWeights.begin(), this->vertexWeights.end(), size_t(0));
+
+    // transpose
+    vertexOffsets.assign(GetNumberOfVertices() + 1, 0);
+    for (auto pin : this->pins) {
+        vertexOffsets[pin + 1]++;
+    }
+    std::partial_sum(vertexOffsets.begin(), vertexOffsets.end(), vertexOffsets.begin());
+    incidentNets.resize(this->pins.size());
+    auto position = vertexOffsets;
+    for (size_t net = 0; net < GetNumberOfNets(); net++) {
+        for (auto pin : GetPins(net)) {
+            incidentNets[position[pin]++] = net;
+        }
+    }
+}
+
+Hypergraph Hypergraph::FromClauses(const Problem& problem)
+{
+    const auto& clauses = problem.GetClauses();
+    auto numberOfVariables = static_cast<size_t>(problem.GetNumberOfVariables());
+
+    // a variable may occur twice in the same clause, count every clause only once
+    std::vector<size_t> count(numberOfVariables + 1, 0);
+    std::vector<size_t> lastClause(numberOfVariables + 1, std::numeric_limits<size_t>::max());
+    for (size_t i = 0; i < clauses.size(); i++) {
+        for (auto literal : clauses[i]) {
+            auto variable = static_cast<size_t>(ToVariable(literal));
+            if (lastClause[variable] != i) {
+                lastClause[variable] = i;
+                count[variable]++;
+            }
+        }
+    }
+
+    std::vector<size_t> netOffsets(1, 0);
+    std::vector<size_t> firstPin(numberOfVariables + 1, 0);
+    for (size_t variable = 1; variable <= numberOfVariables; variable++) {
+        if (count[variable] >= 2) {
+            firstPin[variable] = netOffsets.back();
+            netOffsets.push_back(netOffsets.back() + count[variable]);
+        }
+    }
+
+    std::vector<size_t> pins(netOffsets.back());
+    std::fill(lastClause.begin(), lastClause.end(), std::numeric_limits<size_t>::max());
+    for (size_t i = 0; i < clauses.size(); i++) {
+        for (auto literal : clauses[i]) {
+            auto variable = static_cast<size_t>(ToVariable(literal));
+            if (count[variable] >= 2 && lastClause[variable] != i) {
+                lastClause[variable] = i;
+                pins[firstPin[variable]++] = i;
+            }
+        }
+    }
+
+    return Hypergraph(std::vector<size_t>(clauses.size(), 1), std::move(netOffsets), std::move(pins));
+}
+
+size_t Hypergraph::GetNumberOfVertices() const
+{
+    return vertexWeights.size();
+}
+
+size_t Hypergraph::GetNumberOfNets() const
+{
+    return netOffsets.size() - 1;
+}
+
+size_t Hypergraph::GetVertexWeight(size_t vertex) const
+{
+    return vertexWeights[vertex];
+}
+
+size_t Hypergraph::GetTotalWeight() const
+{
+    return totalWeight;
+}
+
+Hypergraph::Range Hypergraph::GetPins(size_t net) const
+{
+    return {pins.data() + netOffsets[net], pins.data() + netOffsets[net + 1]};
+}
+
+Hypergraph::Range Hypergraph::GetNets(size_t vertex) const
+{
+    return {incidentNets.data() + vertexOffsets[vertex], incidentNets.data() + vertexOffsets[vertex + 1]};
+}
+
+namespace {
+
+/// <summary>
+/// stop coarsening at this number of vertices
+/// </summary>
+const size_t CoarsestSize = 160;
+/// <summary>
+/// stop coarsening if a level removes less than this fraction of the vertices
+/// </summary>
+const double MinimalShrinking = 0.05;
+/// <summary>
+/// nets with more pins are ignored while rating (they hardly tell anything about locality)
+/// </summary>
+const size_t LargeNet = 1000;
+const size_t InitialTries = 8;
+const size_t MaxRefinementPasses = 8;
+
+using Side = uint8_t;
+using Random = std::mt19937_64;
+
+struct Balance {
+    size_t maxWeight[2];
+};
+
+/// <summary>
+/// Heavy-edge matching: pairs every vertex with the unmatched neighbor that shares
+/// the most (small) nets with it. Returns the coarse vertex of every fine vertex.
+/// </summary>
+size_t Match(const Hypergraph& hypergraph, size_t maxVertexWeight, Random& random, std::vector<size_t>& coarseVertex)
+{
+    auto n = hypergraph.GetNumberOfVertices();
+    const auto unmatched = std::numeric_limits<size_t>::max();
+    coarseVertex.assign(n, unmatched);
+
+    std::vector<size_t> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), random);
+
+    std::vector<double> rating(n, 0.0);
+    std::vector<size_t> touched;
+    size_t numberOfCoarseVertices = 0;
+    for (auto u : order) {
+        if (coarseVertex[u] != unmatched) {
+            continue;
+        }
+        for (auto net : hypergraph.GetNets(u)) {
+            auto pins = hypergraph.GetPins(net);
+            if (pins.size() > LargeNet) {
+                continue;
+            }
+            auto score = 1.0 / (pins.size() - 1);
+            for (auto v : pins) {
+                if (v != u && coarseVertex[v] == unmatched) {
+                    if (rating[v] == 0.0) {
+                        touched.push_back(v);
+                    }
+                    rating[v] += score;
+                }
+            }
+        }
+
+        auto best = unmatched;
+        auto bestRating = 0.0;
+        for (auto v : touched) {
+            auto weight = hypergraph.GetVertexWeight(u) + hypergraph.GetVertexWeight(v);
+            if (rating[v] > bestRating && weight <= maxVertexWeight) {
+                best = v;
+                bestRating = rating[v];
+            }
+            rating[v] = 0.0;
+        }
+        touched.clear();
+
+        coarseVertex[u] = numberOfCoarseVertices;
+        if (best != unmatched) {
+            coarseVertex[best] = numberOfCoarseVertices;
+        }
+        numberOfCoarseVertices++;
+    }
+    return numberOfCoarseVertices;
+}
+
+/// <summary>
+/// Contracts the matched vertices. Nets that collapse to a single pin can never be cut and are dropped.
+/// </summary>
+Hypergraph Contract(const Hypergraph& hypergraph, const std::vector<size_t>& coarseVertex, size_t numberOfCoarseVertices)
+{
+    std::vector<size_t> weights(numberOfCoarseVertices, 0);
+    for (size_t v = 0; v < hypergraph.GetNumberOfVertices(); v++) {
+        weights[coarseVertex[v]] += hypergraph.GetVertexWeight(v);
+    }
+
+    std::vector<size_t> netOffsets(1, 0);
+    std::vector<size_t> pins;
+    std::vector<size_t> lastNet(numberOfCoarseVertices, std::numeric_limits<size_t>::max());
+    for (size_t net = 0; net < hypergraph.GetNumberOfNets(); net++) {
+        auto begin = pins.size();
+        for (auto pin : hypergraph.GetPins(net)) {
+            auto coarse = coarseVertex[pin];
+            if (lastNet[coarse] != net) {
+                lastNet[coarse] = net;
+                pins.push_back(coarse);
+            }
+        }
+        if (pins.size() - begin < 2) {
+            pins.resize(begin);
+        } else {
+            netOffsets.push_back(pins.size());
+        }
+    }
+    return Hypergraph(std::move(weights), std::move(netOffsets), std::move(pins));
+}
+
+/// <summary>
+/// Fiduccia-Mattheyses with lazily updated heaps.
+/// Every pass moves each vertex at most once and keeps the best prefix of moves.
+/// </summary>
+class Refiner {
+private:
+    const Hypergraph& hypergraph;
+    const Balance& balance;
+    const std::function<void()>& checkTimeLimit;
+    std::vector<Side>& side;
+
+    std::vector<size_t> pinCount[2];
+    size_t weight[2] = {0, 0};
+    std::vector<long long> gain;
+    std::vector<char> locked;
+    std::priority_queue<std::pair<long long, size_t>> heap[2];
+
+public:
+    Refiner(const Hypergraph& hypergraph, const Balance& balance, const std::function<void()>& checkTimeLimit, std::vector<Side>& side) :
+        hypergraph(hypergraph),
+        balance(balance),
+        checkTimeLimit(checkTimeLimit),
+        side(side)
+    {
+        for (auto& count : pinCount) {
+            count.assign(hypergraph.GetNumberOfNets(), 0);
+        }
+        for (size_t v = 0; v < hypergraph.GetNumberOfVertices(); v++) {
+            weight[side[v]] += hypergraph.GetVertexWeight(v);
+            for (auto net : hypergraph.GetNets(v)) {
+                pinCount[side[v]][net]++;
+            }
+        }
+    }
+
+    size_t GetCut() const
+    {
+        size_t cut = 0;
+        for (size_t net = 0; net < hypergraph.GetNumberOfNets(); net++) {
+            if (pinCount[0][net] > 0 && pinCount[1][net] > 0) {
+                cut++;
+            }
+        }
+        return cut;
+    }
+
+    void Refine()
+    {
+        auto cut = GetCut();
+        for (size_t pass = 0; pass < MaxRefinementPasses && cut > 0; pass++) {
+            checkTimeLimit();
+            auto improved = RunPass(cut);
+            if (!improved) {
+                break;
+            }
+        }
+    }
+
+private:
+    long long ComputeGain(size_t v) const
+    {
+        auto from = side[v];
+        auto to = 1 - from;
+        long long result = 0;
+        for (auto net : hypergraph.GetNets(v)) {
+            if (pinCount[from][net] == 1) {
+                result++;
+            }
+            if (pinCount[to][net] == 0) {
+                result--;
+            }
+        }
+        return result;
+    }
+
+    /// <summary>
+    /// distance to the nearest violated bound, larger is better
+    /// </summary>
+    long long GetSlack() const
+    {
+        return std::min(static_cast<long long>(balance.maxWeight[0]) - static_cast<long long>(weight[0]),
+            static_cast<long long>(balance.maxWeight[1]) - static_cast<long long>(weight[1]));
+    }
+
+    void UpdateGain(size_t v, long long delta)
+    {
+        gain[v] += delta;
+        heap[side[v]].push({gain[v], v});
+    }
+
+    void Move(size_t v, bool updateGains)
+    {
+        auto from = side[v];
+        auto to = 1 - from;
+        for (auto net : hypergraph.GetNets(v)) {
+            if (updateGains) {
+                if (pinCount[to][net] == 0) {
+                    for (auto u : hypergraph.GetPins(net)) {
+                        if (!locked[u]) {
+                            UpdateGain(u, 1);
+                        }
+                    }
+                } else if (pinCount[to][net] == 1) {
+                    for (auto u : hypergraph.GetPins(net)) {
+                        if (side[u] == to && !locked[u]) {
+                            UpdateGain(u, -1);
+                            break;
+                        }
+                    }
+                }
+            }
+            pinCount[from][net]--;
+            pinCount[to][net]++;
+            if (updateGains) {
+                if (pinCount[from][net] == 0) {
+                    for (auto u : hypergraph.GetPins(net)) {
+                        if (!locked[u]) {
+                            UpdateGain(u, -1);
+                        }
+                    }
+                } else if (pinCount[from][net] == 1) {
+                    for (auto u : hypergraph.GetPins(net)) {
+                        if (side[u] == from && !locked[u]) {
+                            UpdateGain(u, 1);
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+        weight[from] -= hypergraph.GetVertexWeight(v);
+        weight[to] += hypergraph.GetVertexWeight(v);
+        side[v] = to;
+    }
+
+    /// <summary>
+    /// removes outdated entries, returns false if the heap is empty
+    /// </summary>
+    bool CleanTop(Side s)
+    {
+        while (!heap[s].empty()) {
+            auto [g, v] = heap[s].top();
+            if (!locked[v] && side[v] == s && gain[v] == g) {
+                return true;
+            }
+            heap[s].pop();
+        }
+        return false;
+    }
+
+    bool RunPass(size_t& cut)
+    {
+        auto n = hypergraph.GetNumberOfVertices();
+        gain.resize(n);
+        locked.assign(n, false);
+        for (auto& h : heap) {
+            h = {};
+        }
+        for (size_t v = 0; v < n; v++) {
+            gain[v] = ComputeGain(v);
+            heap[side[v]].push({gain[v], v});
+        }
+
+        std::vector<size_t> moves;
+        auto bestCut = cut;
+        auto bestSlack = GetSlack();
+        size_t bestLength = 0;
+        auto current = static_cast<long long>(cut);
+        // most improvements are found early, give up after a long streak without one
+        auto maxUselessMoves = 100 + n / 20;
+        size_t uselessMoves = 0;
+
+        while (uselessMoves < maxUselessMoves) {
+            // candidate of each side, vertices that would violate the balance are dropped for this pass
+            std::optional<size_t> candidate[2];
+            for (Side s = 0; s < 2; s++) {
+                while (CleanTop(s)) {
+                    auto v = heap[s].top().second;
+                    if (weight[1 - s] + hypergraph.GetVertexWeight(v) <= balance.maxWeight[1 - s]) {
+                        candidate[s] = v;
+                        break;
+                    }
+                    heap[s].pop();
+                    locked[v] = true;
+                }
+            }
+            if (!candidate[0] && !candidate[1]) {
+                break;
+            }
+
+            size_t v;
+            if (!candidate[1]) {
+                v = candidate[0].value();
+            } else if (!candidate[0]) {
+                v = candidate[1].value();
+            } else if (gain[candidate[0].value()] != gain[candidate[1].value()]) {
+                v = gain[candidate[0].value()] > gain[candidate[1].value()] ? candidate[0].value() : candidate[1].value();
+            } else {
+                // tie: move away from the heavier side
+                v = weight[0] >= weight[1] ? candidate[0].value() : candidate[1].value();
+            }
+
+            heap[side[v]].pop();
+            locked[v] = true;
+            current -= gain[v];
+            Move(v, true);
+            moves.push_back(v);
+
+            auto slack = GetSlack();
+            if (static_cast<size_t>(current) < bestCut || (static_cast<size_t>(current) == bestCut && slack > bestSlack)) {
+                if (static_cast<size_t>(current) < bestCut) {
+                    uselessMoves = 0;
+                }
+                bestCut = static_cast<size_t>(current);
+                bestSlack = slack;
+                bestLength = moves.size();
+            } else {
+                uselessMoves++;
+            }
+            if ((moves.size() & 1023) == 0) {
+                checkTimeLimit();
+            }
+        }
+
+        // roll back everything after the best prefix
+        while (moves.size() > bestLength) {
+            Move(moves.back(), false);
+            moves.pop_back();
+        }
+
+        auto improved = bestCut < cut;
+        cut = bestCut;
+        return improved;
+    }
+};
+
+/// <summary>
+/// Grows part 0 from a random vertex along the nets until it reaches its target weight.
+/// </summary>
+std::vector<Side> GrowBisection(const Hypergraph& hypergraph, size_t targetWeight, Random& random)
+{
+    auto n = hypergraph.GetNumberOfVertices();
+    std::vector<Side> side(n, 1);
+    std::vector<char> visited(n, false);
+    std::vector<size_t> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), random);
+
+    size_t weight = 0;
+    std::queue<size_t> queue;
+    auto next = order.begin();
+    while (weight < targetWeight) {
+        if (queue.empty()) {
+            // start a new region in another connected part
+            while (next != order.end() && visited[*next]) {
+                ++next;
+            }
+            if (next == order.end()) {
+                break;
+            }
+            visited[*next] = true;
+            queue.push(*next);
+        }
+        auto v = queue.front();
+        queue.pop();
+        side[v] = 0;
+        weight += hypergraph.GetVertexWeight(v);
+        for (auto net : hypergraph.GetNets(v)) {
+            for (auto u : hypergraph.GetPins(net)) {
+                if (!visited[u]) {
+                    visited[u] = true;
+                    queue.push(u);
+                }
+            }
+        }
+    }
+    return side;
+}
+
+bool IsBalanced(const Hypergraph& hypergraph, const std::vector<Side>& side, const Balance& balance)
+{
+    size_t weight[2] = {0, 0};
+    for (size_t v = 0; v < hypergraph.GetNumberOfVertices(); v++) {
+        weight[side[v]] += hypergraph.GetVertexWeight(v);
+    }
+    return weight[0] <= balance.maxWeight[0] && weight[1] <= balance.maxWeight[1];
+}
+
+std::vector<Side> InitialBisection(const Hypergraph& hypergraph, size_t targetWeight, const Balance& balance, Random& random, const std::function<void()>& checkTimeLimit)
+{
+    std::vector<Side> best;
+    size_t bestCut = std::numeric_limits<size_t>::max();
+    bool bestBalanced = false;
+    for (size_t i = 0; i < InitialTries; i++) {
+        auto side = GrowBisection(hypergraph, targetWeight, random);
+        Refiner refiner(hypergraph, balance, checkTimeLimit, side);
+        refiner.Refine();
+        auto cut = refiner.GetCut();
+        auto balanced = IsBalanced(hypergraph, side, balance);
+        if ((balanced && !bestBalanced) || (balanced == bestBalanced && cut < bestCut)) {
+            best = std::move(side);
+            bestCut = cut;
+            bestBalanced = balanced;
+        }
+    }
+    return best;
+}
+
+/// <summary>
+/// Multilevel bisection, part 0 should get ratio of the total weight.
+/// </summary>
+std::vector<Side> Bisect(const Hypergraph& hypergraph, double ratio, double imbalance, Random& random, const std::function<void()>& checkTimeLimit)
+{
+    auto total = hypergraph.GetTotalWeight();
+    auto targetWeight = static_cast<size_t>(ratio * total + 0.5);
+
+    // coarsening
+    std::vector<Hypergraph> levels;
+    std::vector<std::vector<size_t>> maps;
+    const Hypergraph* current = &hypergraph;
+    auto maxVertexWeight = std::max<size_t>(1, total / CoarsestSize);
+    while (current->GetNumberOfVertices() > CoarsestSize) {
+        checkTimeLimit();
+        std::vector<size_t> coarseVertex;
+        auto numberOfCoarseVertices = Match(*current, maxVertexWeight, random, coarseVertex);
+        if (numberOfCoarseVertices > (1.0 - MinimalShrinking) * current->GetNumberOfVertices()) {
+            break;
+        }
+        levels.push_back(Contract(*current, coarseVertex, numberOfCoarseVertices));
+        maps.push_back(std::move(coarseVertex));
+        current = &levels.back();
+    }
+
+    // the bound must leave room for the heaviest vertex, otherwise no move is possible
+    size_t heaviest = 0;
+    for (size_t v = 0; v < current->GetNumberOfVertices(); v++) {
+        heaviest = std::max(heaviest, current->GetVertexWeight(v));
+    }
+    Balance balance;
+    balance.maxWeight[0] = std::max(static_cast<size_t>((1.0 + imbalance) * ratio * total), targetWeight + heaviest);
+    balance.maxWeight[1] = std::max(static_cast<size_t>((1.0 + imbalance) * (1.0 - ratio) * total), total - targetWeight + heaviest);
+
+    auto side = InitialBisection(*current, targetWeight, balance, random, checkTimeLimit);
+
+    // uncoarsening
+    for (auto level = levels.size(); level-- > 0;) {
+        const auto& finer = level == 0 ? hypergraph : levels[level - 1];
+        std::vector<Side> projected(finer.GetNumberOfVertices());
+        for (size_t v = 0; v < projected.size(); v++) {
+            projected[v] = side[maps[level][v]];
+        }
+        side = std::move(projected);
+        Refiner refiner(finer, balance, checkTimeLimit, side);
+        refiner.Refine();
+    }
+    return side;
+}
+
+/// <summary>
+/// Hypergraph induced by the vertices of one side.
+/// Nets with pins on both sides are already cut and are left out.
+/// </summary>
+Hypergraph Extract(const Hypergraph& hypergraph, const std::vector<Side>& side, Side which, std::vector<size_t>& vertices)
+{
+    std::vector<size_t> newVertex(hypergraph.GetNumberOfVertices(), std::numeric_limits<size_t>::max());
+    std::vector<size_t> weights;
+    std::vector<size_t> subVertices;
+    for (size_t v = 0; v < hypergraph.GetNumberOfVertices(); v++) {
+        if (side[v] == which) {
+            newVertex[v] = weights.size();
+            weights.push_back(hypergraph.GetVertexWeight(v));
+            subVertices.push_back(vertices[v]);
+        }
+    }
+
+    std::vector<size_t> netOffsets(1, 0);
+    std::vector<size_t> pins;
+    for (size_t net = 0; net < hypergraph.GetNumberOfNets(); net++) {
+        auto netPins = hypergraph.GetPins(net);
+        auto inside = std::all_of(netPins.begin(), netPins.end(), [&](auto pin) {
+            return side[pin] == which;
+        });
+        if (inside) {
+            for (auto pin : netPins) {
+                pins.push_back(newVertex[pin]);
+            }
+            netOffsets.push_back(pins.size());
+        }
+    }
+
+    vertices = std::move(subVertices);
+    return Hypergraph(std::move(weights), std::move(netOffsets), std::move(pins));
+}
+
+void PartitionRecursive(const Hypergraph& hypergraph, std::vector<size_t> vertices, size_t numberOfPartitions, size_t firstPartition, double imbalance, Random& random, const std::function<void()>& checkTimeLimit, std::vector<size_t>& result)
+{
+    if (numberOfPartitions == 1 || hypergraph.GetNumberOfVertices() <= 1) {
+        for (auto v : vertices) {
+            result[v] = firstPartition;
+        }
+        return;
+    }
+
+    auto left = numberOfPartitions / 2;
+    auto side = Bisect(hypergraph, static_cast<double>(left) / numberOfPartitions, imbalance, random, checkTimeLimit);
+
+    for (Side s = 0; s < 2; s++) {
+        auto subVertices = vertices;
+        auto sub = Extract(hypergraph, side, s, subVertices);
+        if (s == 0) {
+            PartitionRecursive(sub, std::move(subVertices), left, firstPartition, imbalance, random, checkTimeLimit, result);
+        } else {
+            PartitionRecursive(sub, std::move(subVertices), numberOfPartitions - left, firstPartition + left, imbalance, random, checkTimeLimit, result);
+        }
+    }
+}
+
+}
+
+std::vector<size_t> PartitionHypergraph(const Hypergraph& hypergraph, size_t numberOfPartitions, double imbalance, uint64_t seed, const std::function<void()>& checkTimeLimit)
+{
+    if (numberOfPartitions == 0) {
+        throw std::invalid_argument("number of partitions must not be 0");
+    }
+    std::vector<size_t> result(hypergraph.GetNumberOfVertices(), 0);
+    std::vector<size_t> vertices(hypergraph.GetNumberOfVertices());
+    std::iota(vertices.begin(), vertices.end(), 0);
+    Random random(seed);
+    PartitionRecursive(hypergraph, std::move(vertices), numberOfPartitions, 0, imbalance, random, checkTimeLimit, result);
+    return result;
+}
+
+size_t GetCut(const Hypergraph& hypergraph, const std::vector<size_t>& partition)
+{
+    size_t cut = 0;
+    for (size_t net = 0; net < hypergraph.GetNumberOfNets(); net++) {
+        auto pins = hypergraph.GetPins(net);
+        if (pins.size() == 0) {
+            continue;
+        }
+        auto first = partition[*pins.begin()];
+        auto isCut = std::any_of(pins.begin(), pins.end(), [&](auto pin) {
+            return partition[pin] != first;
+        });
+        if (isCut) {
+            cut++;
+        }
+    }
+    return cut;
+}
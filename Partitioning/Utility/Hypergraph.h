@@ -0,0 +1,94 @@
+#pragma once
+
+#include "Partitioning/DLLMakro.h"
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "Core/Types/Problem.h"
+
+/// <summary>
+/// Weighted hypergraph in compressed sparse row format.
+/// Nets (hyperedges) are stored as lists of pins (vertices) and vice versa.
+/// </summary>
+class PARTITIONINING_API Hypergraph {
+public:
+    /// <summary>
+    /// pins of a net or nets of a vertex
+    /// </summary>
+    struct Range {
+        const size_t* first;
+        const size_t* last;
+
+        const size_t* begin() const
+        {
+            return first;
+        }
+        const size_t* end() const
+        {
+            return last;
+        }
+        size_t size() const
+        {
+            return last - first;
+        }
+    };
+
+private:
+    std::vector<size_t> vertexWeights;
+    std::vector<size_t> netOffsets;
+    std::vector<size_t> pins;
+    std::vector<size_t> vertexOffsets;
+    std::vector<size_t> incidentNets;
+    size_t totalWeight = 0;
+
+public:
+    Hypergraph() = default;
+    /// <summary>
+    /// pins of net e are pins[netOffsets[e]] .. pins[netOffsets[e + 1] - 1]
+    /// </summary>
+    /// <param name="vertexWeights"></param>
+    /// <param name="netOffsets">size: number of nets + 1</param>
+    /// <param name="pins"></param>
+    Hypergraph(std::vector<size_t>&& vertexWeights, std::vector<size_t>&& netOffsets, std::vector<size_t>&& pins);
+
+    /// <summary>
+    /// Every clause is a vertex, every variable is a net over the clauses it occurs in.
+    /// Hence a cut net is exactly a variable that is shared by two partitions.
+    /// Variables with less than two clauses can never be cut and are left out.
+    /// </summary>
+    /// <param name="problem"></param>
+    /// <returns></returns>
+    static Hypergraph FromClauses(const Problem& problem);
+
+public:
+    size_t GetNumberOfVertices() const;
+    size_t GetNumberOfNets() const;
+    size_t GetVertexWeight(size_t vertex) const;
+    size_t GetTotalWeight() const;
+    Range GetPins(size_t net) const;
+    Range GetNets(size_t vertex) const;
+};
+
+/// <summary>
+/// Multilevel partitioning into numberOfPartitions blocks by recursive bisection:
+/// heavy-edge coarsening, greedy growing on the coarsest level and
+/// Fiduccia-Mattheyses refinement on every level.
+/// Minimizes the number of cut nets, every block weighs at most (1 + imbalance) times its share.
+/// </summary>
+/// <param name="hypergraph"></param>
+/// <param name="numberOfPartitions"></param>
+/// <param name="imbalance"></param>
+/// <param name="seed"></param>
+/// <param name="checkTimeLimit">called regularly, may throw to abort</param>
+/// <returns>block of each vertex</returns>
+PARTITIONINING_API std::vector<size_t> PartitionHypergraph(const Hypergraph& hypergraph, size_t numberOfPartitions, double imbalance, uint64_t seed, const std::function<void()>& checkTimeLimit);
+
+/// <summary>
+/// number of nets with pins in more than one block
+/// </summary>
+/// <param name="hypergraph"></param>
+/// <param name="partition"></param>
+/// <returns></returns>
+PARTITIONINING_API size_t GetCut(const Hypergraph& hypergraph, const std::vector<size_t>& partition);
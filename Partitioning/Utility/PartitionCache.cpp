@@ -0,0 +1,45 @@
+#include "Partitioning/stdafx.h"
+#include "PartitionCache.h"
+
+PartitionCache::PartitionCache(size_t numberOfPartitions, size_t maxSize) :
+    entries(numberOfPartitions),
+    maxSize(maxSize)
+{
+}
+
+std::optional<PartitionCache::Entry> PartitionCache::Find(size_t partition, const Restriction& restriction)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& partitionEntries = entries[partition];
+    auto it = partitionEntries.find(restriction);
+    if (it == partitionEntries.end()) {
+        misses++;
+        return {};
+    }
+    hits++;
+    return it->second;
+}
+
+void PartitionCache::Insert(size_t partition, const Restriction& restriction, Entry entry)
+{
+    // node and bucket of the map, the restriction and the model with its control block
+    auto entrySize = 128 + restriction.size() / 8 + (entry ? 64 + static_cast<size_t>(entry->GetNumberOfVariables()) : 0);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (size + entrySize > maxSize) {
+        return;
+    }
+    if (entries[partition].emplace(restriction, std::move(entry)).second) {
+        size += entrySize;
+    }
+}
+
+size_t PartitionCache::GetHits() const
+{
+    return hits;
+}
+
+size_t PartitionCache::GetMisses() const
+{
+    return misses;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "Core/Types/Assignment.h"
+
+/// <summary>
+/// Results of partitions under a restriction of their cut variables.
+/// A partition only contains its own clauses, so the result does not depend on other cut variables.
+/// Once full, new results are not stored anymore.
+/// Thread safe.
+/// </summary>
+class PartitionCache {
+public:
+    /// <summary>
+    /// approximate memory of the stored results in bytes
+    /// </summary>
+    static const size_t DefaultMaxSize = size_t(32) << 20;
+
+    /// <summary>
+    /// model of the partition, nullptr if it is unsatisfiable
+    /// </summary>
+    using Entry = std::shared_ptr<const Assignment>;
+    /// <summary>
+    /// values of the cut variables of a partition (in a fixed order)
+    /// </summary>
+    using Restriction = std::vector<bool>;
+
+private:
+    std::mutex mutex;
+    std::vector<std::unordered_map<Restriction, Entry>> entries;
+    size_t size = 0;
+    size_t maxSize;
+    std::atomic<size_t> hits{0};
+    std::atomic<size_t> misses{0};
+
+public:
+    explicit PartitionCache(size_t numberOfPartitions, size_t maxSize = DefaultMaxSize);
+
+public:
+    std::optional<Entry> Find(size_t partition, const Restriction& restriction);
+    /// <summary>
+    /// only definite results (satisfiable or unsatisfiable) may be inserted
+    /// </summary>
+    /// <param name="partition"></param>
+    /// <param name="restriction"></param>
+    /// <param name="entry"></param>
+    void Insert(size_t partition, const Restriction& restriction, Entry entry);
+
+    size_t GetHits() const;
+    size_t GetMisses() const;
+};
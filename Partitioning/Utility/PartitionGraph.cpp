@@ -0,0 +1,370 @@
+#include "Partitioning/stdafx.h"
+#include "PartitionGraph.h"
+
+#include <algorithm>
+#include <numeric>
+#include <optional>
+#include <queue>
+
+PartitionGraph::PartitionGraph(Variable numberOfVariables, std::vector<Partition>&& partitions) :
+    groups(std::move(partitions)),
+    removed(groups.size(), false),
+    unionFind(groups.size()),
+    slots(groups.size()),
+    keys(groups.size()),
+    occurrenceOffsets(static_cast<size_t>(numberOfVariables) + 2, 0),
+    memberCounts(static_cast<size_t>(numberOfVariables) + 1, 0)
+{
+    std::iota(slots.begin(), slots.end(), 0);
+    std::iota(keys.begin(), keys.end(), 0);
+
+    // counting sort of the partitions by variable
+    for (size_t slot = 0; slot < groups.size(); slot++) {
+        for (auto variable : groups[slot].variables) {
+            occurrenceOffsets[variable + 1]++;
+            memberCounts[variable]++;
+        }
+    }
+    for (size_t i = 1; i < occurrenceOffsets.size(); i++) {
+        occurrenceOffsets[i] += occurrenceOffsets[i - 1];
+    }
+    occurrences.resize(occurrenceOffsets.back());
+    auto positions = occurrenceOffsets;
+    for (size_t slot = 0; slot < groups.size(); slot++) {
+        for (auto variable : groups[slot].variables) {
+            occurrences[positions[variable]++] = slot;
+        }
+    }
+}
+
+void PartitionGraph::MergeSharedPairs(const std::function<void()>& checkTimeLimit)
+{
+    // hits of a partition are only valid if its stamp is the current one
+    std::vector<size_t> stamps(groups.size(), None);
+    std::vector<size_t> hits(groups.size(), 0);
+    size_t stamp = 0;
+    // a merged partition occurs several times in the occurrence list of a variable
+    std::vector<size_t> visits(groups.size(), None);
+    size_t visit = 0;
+
+    // reused for every partition
+    std::vector<Variable> queue;
+
+    auto order = GetOrder();
+    std::vector<size_t> orderKeys;
+    for (auto slot : order) {
+        orderKeys.push_back(keys[slot]);
+    }
+    for (size_t i = 0; i < order.size(); i++) {
+        auto slot = order[i];
+        if (!IsAlive(slot) || keys[slot] != orderKeys[i] || groups[slot].variables.empty()) {
+            // merged into a partition before, possibly keeping its data in this slot
+            continue;
+        }
+        checkTimeLimit();
+
+        stamp++;
+        auto current = slot;
+        // partitions with two common variables, they are merged by their keys like a scan over the partitions
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> candidates;
+        // the variable in the most partitions is only looked up, never scanned
+        auto skipped = *std::max_element(groups[current].variables.begin(), groups[current].variables.end(), [this](auto l, auto r) {
+            return memberCounts[l] < memberCounts[r];
+        });
+        queue.assign(groups[current].variables.begin(), groups[current].variables.end());
+        size_t next = 0;
+        auto scan = [&]() {
+            for (; next < queue.size(); next++) {
+                auto variable = queue[next];
+                if (variable == skipped) {
+                    continue;
+                }
+                visit++;
+                for (auto i = occurrenceOffsets[variable]; i < occurrenceOffsets[variable + 1]; i++) {
+                    auto other = GetSlot(occurrences[i]);
+                    if (other == current || removed[other] || visits[other] == visit) {
+                        continue;
+                    }
+                    visits[other] = visit;
+                    if (stamps[other] != stamp) {
+                        stamps[other] = stamp;
+                        hits[other] = groups[other].variables.count(skipped);
+                    }
+                    if (++hits[other] == 2) {
+                        candidates.push({keys[other], other});
+                    }
+                }
+            }
+        };
+
+        scan();
+        auto position = None;
+        while (!candidates.empty()) {
+            auto [key, other] = candidates.top();
+            candidates.pop();
+            if (position != None && key < position) {
+                // passed before it had two common variables
+                continue;
+            }
+            position = key;
+
+            // the new variables are scanned as well
+            for (auto otherVariable : groups[other].variables) {
+                if (groups[current].variables.find(otherVariable) == groups[current].variables.end()) {
+                    queue.push_back(otherVariable);
+                }
+            }
+            current = Merge(current, other);
+            scan();
+        }
+    }
+}
+
+std::vector<Clause> PartitionGraph::MergeSingleClauses(const std::function<void()>& checkTimeLimit)
+{
+    // partitions of each variable, the largest key first, and the partitions with several clauses, the smallest key first;
+    // a merged partition gets new entries, the outdated ones are dropped when they come up
+    std::vector<std::priority_queue<Entry>> last(memberCounts.size());
+    std::vector<std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>>> firstMulti(memberCounts.size());
+    auto order = GetOrder();
+    for (auto slot : order) {
+        for (auto variable : groups[slot].variables) {
+            last[variable].push({keys[slot], slot});
+            if (groups[slot].clauses.size() > 1) {
+                firstMulti[variable].push({keys[slot], slot});
+            }
+        }
+    }
+    auto top = [this](auto& heap) {
+        while (!heap.empty() && !IsCurrent(heap.top())) {
+            heap.pop();
+        }
+        return heap.empty() ? std::optional<Entry>() : heap.top();
+    };
+
+    std::vector<Clause> looseClauses;
+    for (auto slot : order) {
+        if (!IsAlive(slot) || groups[slot].clauses.size() != 1) {
+            continue;
+        }
+        checkTimeLimit();
+
+        // connected partition with the largest key and partition with several clauses with the smallest key
+        std::optional<Entry> lastConnected;
+        std::optional<Entry> firstConnectedMulti;
+        Entry self{keys[slot], slot};
+        for (auto variable : groups[slot].variables) {
+            auto& heap = last[variable];
+            auto entry = top(heap);
+            if (entry == self) {
+                heap.pop();
+                entry = top(heap);
+                heap.push(self);
+            }
+            if (entry && (!lastConnected || entry->first > lastConnected->first)) {
+                lastConnected = entry;
+            }
+            auto multi = top(firstMulti[variable]);
+            if (multi && (!firstConnectedMulti || multi->first < firstConnectedMulti->first)) {
+                firstConnectedMulti = multi;
+            }
+        }
+
+        if (!lastConnected) {
+            // this clause is loose
+            looseClauses.push_back(std::move(groups[slot].clauses[0]));
+            Remove(slot);
+            continue;
+        }
+        if (firstConnectedMulti && lastConnected->first != firstConnectedMulti->first) {
+            // connected with a partition after the first one with several clauses
+            continue;
+        }
+
+        auto target = GetSlot(lastConnected->second);
+        auto wasMulti = groups[target].clauses.size() > 1;
+        std::vector<Variable> gained;
+        for (auto variable : groups[slot].variables) {
+            if (groups[target].variables.find(variable) == groups[target].variables.end()) {
+                gained.push_back(variable);
+            }
+        }
+        auto merged = Merge(target, slot);
+        Entry entry{keys[merged], merged};
+        for (auto variable : gained) {
+            last[variable].push(entry);
+        }
+        if (wasMulti) {
+            for (auto variable : gained) {
+                firstMulti[variable].push(entry);
+            }
+        } else {
+            for (auto variable : groups[merged].variables) {
+                firstMulti[variable].push(entry);
+            }
+        }
+    }
+    return looseClauses;
+}
+
+void PartitionGraph::MergeConnections(const std::function<void()>& checkTimeLimit)
+{
+    auto order = GetOrder();
+    std::stable_sort(order.begin(), order.end(), [this](auto l, auto r) {
+        return groups[l].clauses.size() < groups[r].clauses.size();
+    });
+    // a merged partition keeps the rank of the partition the clause was merged into
+    std::vector<size_t> ranks(groups.size(), None);
+    for (size_t i = 0; i < order.size(); i++) {
+        ranks[order[i]] = i;
+    }
+
+    // partitions of variable v by rank are members[memberOffsets[v]] .. members[memberOffsets[v + 1] - 1],
+    // the ones in front of cursors[v] were merged into other partitions
+    std::vector<size_t> memberOffsets(memberCounts.size() + 1, 0);
+    for (auto slot : order) {
+        for (auto variable : groups[slot].variables) {
+            memberOffsets[variable + 1]++;
+        }
+    }
+    for (size_t i = 1; i < memberOffsets.size(); i++) {
+        memberOffsets[i] += memberOffsets[i - 1];
+    }
+    std::vector<size_t> members(memberOffsets.back());
+    std::vector<size_t> cursors(memberOffsets.begin(), memberOffsets.end() - 1);
+    {
+        auto positions = cursors;
+        for (auto slot : order) {
+            for (auto variable : groups[slot].variables) {
+                members[positions[variable]++] = slot;
+            }
+        }
+    }
+    std::vector<bool> absorbed(groups.size(), false);
+    // best partition that got the variable from a merged clause
+    std::vector<size_t> gained(memberCounts.size(), None);
+
+    for (auto slot : order) {
+        if (!IsAlive(slot) || groups[slot].clauses.size() != 1) {
+            // not a connection
+            continue;
+        }
+        checkTimeLimit();
+
+        // the partition with the lowest rank that contains a variable of the clause
+        auto target = None;
+        for (auto variable : groups[slot].variables) {
+            auto& cursor = cursors[variable];
+            while (cursor < memberOffsets[variable + 1] && absorbed[members[cursor]]) {
+                cursor++;
+            }
+            for (auto i = cursor; i < memberOffsets[variable + 1]; i++) {
+                auto candidate = members[i];
+                if (candidate != slot && !absorbed[candidate]) {
+                    if (target == None || ranks[candidate] < ranks[target]) {
+                        target = candidate;
+                    }
+                    break;
+                }
+            }
+            auto candidate = gained[variable];
+            if (candidate != None && (target == None || ranks[candidate] < ranks[target])) {
+                target = candidate;
+            }
+        }
+        if (target == None) {
+            continue;
+        }
+
+        absorbed[slot] = true;
+        for (auto variable : groups[slot].variables) {
+            if (gained[variable] == None || ranks[target] < ranks[gained[variable]]) {
+                gained[variable] = target;
+            }
+        }
+        Merge(GetSlot(target), slot);
+    }
+
+    // the partitions stay in this order
+    for (auto slot : order) {
+        if (!absorbed[slot]) {
+            keys[GetSlot(slot)] = ranks[slot];
+        }
+    }
+}
+
+std::vector<Partition> PartitionGraph::ExtractPartitions()
+{
+    std::vector<Partition> partitions;
+    for (auto slot : GetOrder()) {
+        partitions.push_back(std::move(groups[slot]));
+    }
+    groups.clear();
+    return partitions;
+}
+
+size_t PartitionGraph::GetSlot(size_t partition)
+{
+    return slots[unionFind.Find(partition)];
+}
+
+bool PartitionGraph::IsAlive(size_t slot)
+{
+    return !removed[slot] && GetSlot(slot) == slot;
+}
+
+std::vector<size_t> PartitionGraph::GetOrder()
+{
+    std::vector<size_t> order;
+    for (size_t slot = 0; slot < groups.size(); slot++) {
+        if (IsAlive(slot)) {
+            order.push_back(slot);
+        }
+    }
+    std::sort(order.begin(), order.end(), [this](auto l, auto r) {
+        return keys[l] < keys[r];
+    });
+    return order;
+}
+
+bool PartitionGraph::IsCurrent(const Entry& entry)
+{
+    auto slot = GetSlot(entry.second);
+    return !removed[slot] && keys[slot] == entry.first;
+}
+
+size_t PartitionGraph::Merge(size_t into, size_t from)
+{
+    auto key = keys[into];
+    auto l = into;
+    auto r = from;
+    if (groups[l].variables.size() < groups[r].variables.size()) {
+        std::swap(l, r);
+    }
+    auto& large = groups[l];
+    auto& small = groups[r];
+
+    for (auto variable : small.variables) {
+        if (!large.variables.insert(variable).second) {
+            memberCounts[variable]--;
+        }
+    }
+    std::move(small.clauses.begin(), small.clauses.end(), std::back_inserter(large.clauses));
+    small.clauses.clear();
+    small.variables.clear();
+
+    unionFind.Union(l, r);
+    slots[unionFind.Find(l)] = l;
+    keys[l] = key;
+    return l;
+}
+
+void PartitionGraph::Remove(size_t slot)
+{
+    for (auto variable : groups[slot].variables) {
+        memberCounts[variable]--;
+    }
+    groups[slot].clauses.clear();
+    groups[slot].variables.clear();
+    removed[slot] = true;
+}
@@ -0,0 +1,156 @@
+#pragma once
+
+#include "Partitioning/DLLMakro.h"
+
+#include <functional>
+#include <limits>
+#include <memory_resource>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "Core/Types/Problem.h"
+#include "Core/Utility/UnionFind.h"
+
+struct Partition {
+    std::vector<Clause> clauses;
+    /// <summary>
+    /// usually in the arena of the solve (see SolveArena), copies use the default resource
+    /// </summary>
+    std::pmr::set<Variable> variables;
+
+    Partition(const std::vector<Clause>& clauses, const std::pmr::set<Variable>& variables) :
+        clauses(clauses), variables(variables)
+    {
+    }
+
+    Partition(std::vector<Clause>&& clauses, std::pmr::set<Variable>&& variables) :
+        clauses(std::move(clauses)), variables(std::move(variables))
+    {
+    }
+    Partition(const Partition& other) :
+        clauses(other.clauses), variables(other.variables)
+    {
+    }
+
+    // noexcept, so growing a vector of partitions moves instead of copying them
+    Partition(Partition&& other) noexcept :
+        clauses(std::move(other.clauses)), variables(std::move(other.variables))
+    {
+    }
+    Partition& operator=(const Partition& other)
+    {
+        if (&other != this) {
+            clauses = other.clauses;
+            variables = other.variables;
+        }
+        return *this;
+    }
+    Partition& operator=(Partition&& other) noexcept
+    {
+        if (&other != this) {
+            clauses = std::move(other.clauses);
+            variables = std::move(other.variables);
+        }
+        return *this;
+    }
+};
+
+/// <summary>
+/// Merges partitions along their shared variables without comparing all pairs of partitions.
+/// The phases give the same partitions as the pairwise scans over the partition vector they replace:
+/// every partition keeps the position (key) of the partition it was merged into, and the partitions
+/// are visited by their keys. The partitions that contain a variable are found through the occurrence list of the variable.
+/// Merged partitions are tracked in a union-find, the data of a merged partition is kept in the slot
+/// of the partition with more variables, so every variable changes its slot O(log n) times
+/// (the order of the clauses within a partition differs from the vector scans).
+/// </summary>
+class PARTITIONINING_API PartitionGraph {
+private:
+    static constexpr size_t None = std::numeric_limits<size_t>::max();
+
+    /// <summary>
+    /// key and slot of a partition
+    /// </summary>
+    using Entry = std::pair<size_t, size_t>;
+
+    /// <summary>
+    /// data of the merged partition (slot), empty for absorbed and removed partitions
+    /// </summary>
+    std::vector<Partition> groups;
+    std::vector<bool> removed;
+    UnionFind unionFind;
+    /// <summary>
+    /// slot of each union-find root
+    /// </summary>
+    std::vector<size_t> slots;
+    /// <summary>
+    /// position of the partition in the slot among the partitions, initially the index
+    /// </summary>
+    std::vector<size_t> keys;
+
+    /// <summary>
+    /// initial partitions of variable v are occurrences[occurrenceOffsets[v]] .. occurrences[occurrenceOffsets[v + 1] - 1]
+    /// </summary>
+    std::vector<size_t> occurrenceOffsets;
+    std::vector<size_t> occurrences;
+
+    /// <summary>
+    /// number of partitions that contain the variable
+    /// </summary>
+    std::vector<size_t> memberCounts;
+
+public:
+    PartitionGraph(Variable numberOfVariables, std::vector<Partition>&& partitions);
+
+public:
+    /// <summary>
+    /// Visits the partitions by their keys and merges every partition into the visited one that has
+    /// at least two variables in common with it when it is reached. The partitions are reached by their keys,
+    /// a partition that gets two common variables after it was passed is left for a later call.
+    /// </summary>
+    /// <param name="checkTimeLimit">called regularly, may throw to abort</param>
+    void MergeSharedPairs(const std::function<void()>& checkTimeLimit);
+
+    /// <summary>
+    /// Visits the single clauses by their keys and merges each into the partition it is connected with:
+    /// the first partition with several clauses if no connected partition comes after it,
+    /// otherwise the last connected single clause if it is not connected with a partition with several clauses.
+    /// Clauses without any connection are removed.
+    /// </summary>
+    /// <param name="checkTimeLimit">called regularly, may throw to abort</param>
+    /// <returns>removed clauses, they share no variable with any other clause</returns>
+    std::vector<Clause> MergeSingleClauses(const std::function<void()>& checkTimeLimit);
+
+    /// <summary>
+    /// Merges every remaining single clause, smallest partitions first, into the smallest partition
+    /// (by number of clauses, then by key) it is connected with, including the variables gained from clauses merged before.
+    /// The sizes are taken once before merging, a merged partition keeps its place in this order.
+    /// Afterwards the keys follow this order.
+    /// </summary>
+    /// <param name="checkTimeLimit">called regularly, may throw to abort</param>
+    void MergeConnections(const std::function<void()>& checkTimeLimit);
+
+    /// <summary>
+    /// moves the merged partitions out by their keys, the graph is empty afterwards
+    /// </summary>
+    /// <returns></returns>
+    std::vector<Partition> ExtractPartitions();
+
+private:
+    size_t GetSlot(size_t partition);
+    bool IsAlive(size_t slot);
+    /// <summary>
+    /// live slots by key
+    /// </summary>
+    std::vector<size_t> GetOrder();
+    /// <summary>
+    /// the partition in the slot still has the key of the entry
+    /// </summary>
+    bool IsCurrent(const Entry& entry);
+    /// <summary>
+    /// merges the slot from into the slot into, returns the slot that keeps the data (with the key of into)
+    /// </summary>
+    size_t Merge(size_t into, size_t from);
+    void Remove(size_t slot);
+};
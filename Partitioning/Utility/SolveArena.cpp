@@ -0,0 +1,12 @@
+#include "Partitioning/stdafx.h"
+#include "SolveArena.h"
+
+std::pmr::memory_resource* SolveArena::GetResource()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& resource = resources[std::this_thread::get_id()];
+    if (!resource) {
+        resource = std::make_unique<std::pmr::monotonic_buffer_resource>();
+    }
+    return resource.get();
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <thread>
+
+/// <summary>
+/// Memory of one Solve call of a partitioner, released at once when the arena is destroyed.
+/// Every thread allocates from its own monotonic buffer, so the parallel phases do not contend for a lock.
+/// Deallocation does nothing, so objects may be destroyed by any thread, but a container must only grow
+/// in the thread that created it and nothing allocated in the arena may outlive it.
+/// </summary>
+class SolveArena {
+private:
+    std::mutex mutex;
+    std::map<std::thread::id, std::unique_ptr<std::pmr::monotonic_buffer_resource>> resources;
+
+public:
+    SolveArena() = default;
+    SolveArena(const SolveArena&) = delete;
+    SolveArena& operator=(const SolveArena&) = delete;
+
+public:
+    /// <summary>
+    /// buffer of the calling thread, look it up once per phase or task and not per allocation
+    /// </summary>
+    /// <returns></returns>
+    std::pmr::memory_resource* GetResource();
+};
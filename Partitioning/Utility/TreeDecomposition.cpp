@@ -0,0 +1,200 @@
+#include "Partitioning/stdafx.h"
+#include "TreeDecomposition.h"
+
+#include <algorithm>
+#include <queue>
+#include <tuple>
+#include <unordered_set>
+
+namespace {
+
+using Neighbors = std::vector<std::unordered_set<Variable>>;
+/// <summary>
+/// primary and secondary key of the heuristic, smaller is eliminated first
+/// </summary>
+using Score = std::pair<size_t, size_t>;
+
+constexpr size_t Unknown = std::numeric_limits<size_t>::max();
+
+/// <summary>
+/// number of edges the elimination of the variable adds
+/// </summary>
+size_t CountFill(const Neighbors& neighbors, Variable variable)
+{
+    const auto& own = neighbors[variable];
+    size_t connected = 0;
+    for (auto neighbor : own) {
+        const auto& other = neighbors[neighbor];
+        if (other.size() < own.size()) {
+            connected += std::count_if(other.begin(), other.end(), [&own](auto v) {
+                return own.find(v) != own.end();
+            });
+        } else {
+            connected += std::count_if(own.begin(), own.end(), [&other](auto v) {
+                return other.find(v) != other.end();
+            });
+        }
+    }
+    auto degree = own.size();
+    // every edge between two neighbors was counted twice
+    return degree * (degree - 1) / 2 - connected / 2;
+}
+
+Score GetScore(const Neighbors& neighbors, Variable variable, EliminationHeuristic heuristic, size_t maxSeparatorSize)
+{
+    auto degree = neighbors[variable].size();
+    if (heuristic == EliminationHeuristic::MinDegree) {
+        return {degree, 0};
+    }
+    // the fill of variables that can not be eliminated yet is not worth computing
+    return {degree > maxSeparatorSize ? Unknown : CountFill(neighbors, variable), degree};
+}
+
+}
+
+std::vector<Variable> TreeDecomposition::GetSeparator(size_t bag) const
+{
+    std::vector<Variable> separator;
+    if (parents[bag] != None) {
+        const auto& parent = bags[parents[bag]];
+        std::set_intersection(bags[bag].begin(), bags[bag].end(), parent.begin(), parent.end(), std::back_inserter(separator));
+    }
+    return separator;
+}
+
+std::optional<TreeDecomposition> DecomposeTree(const Problem& problem, EliminationHeuristic heuristic, size_t maxSeparatorSize, size_t minClausesPerBag, const std::function<void()>& checkTimeLimit)
+{
+    auto numberOfVariables = static_cast<size_t>(problem.GetNumberOfVariables());
+    const auto& clauses = problem.GetClauses();
+
+    // primal graph
+    Neighbors neighbors(numberOfVariables + 1);
+    std::vector<bool> occurs(numberOfVariables + 1, false);
+    for (const auto& clause : clauses) {
+        if (clause.empty()) {
+            // fits into no bag
+            return {};
+        }
+        for (auto l : clause) {
+            occurs[ToVariable(l)] = true;
+            for (auto r : clause) {
+                if (ToVariable(l) != ToVariable(r)) {
+                    neighbors[ToVariable(l)].insert(ToVariable(r));
+                }
+            }
+        }
+    }
+    checkTimeLimit();
+
+    // elimination, the heap may contain outdated scores
+    using Entry = std::tuple<size_t, size_t, Variable>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+    std::vector<Score> scores(numberOfVariables + 1);
+    for (Variable variable = FirstVariable; variable <= problem.GetNumberOfVariables(); variable++) {
+        if (occurs[variable]) {
+            scores[variable] = GetScore(neighbors, variable, heuristic, maxSeparatorSize);
+            heap.emplace(scores[variable].first, scores[variable].second, variable);
+        }
+    }
+
+    std::vector<Variable> order;
+    std::vector<size_t> positions(numberOfVariables + 1, Unknown);
+    std::vector<std::vector<Variable>> eliminationBags(numberOfVariables + 1);
+    while (!heap.empty()) {
+        auto [primary, secondary, variable] = heap.top();
+        heap.pop();
+        if (positions[variable] != Unknown || scores[variable] != Score(primary, secondary)) {
+            continue;
+        }
+        if (order.size() % 1024 == 0) {
+            checkTimeLimit();
+        }
+        if (neighbors[variable].size() > maxSeparatorSize) {
+            return {};
+        }
+
+        std::vector<Variable> bag(neighbors[variable].begin(), neighbors[variable].end());
+        for (size_t i = 0; i < bag.size(); i++) {
+            neighbors[bag[i]].erase(variable);
+            for (size_t j = i + 1; j < bag.size(); j++) {
+                neighbors[bag[i]].insert(bag[j]);
+                neighbors[bag[j]].insert(bag[i]);
+            }
+        }
+        neighbors[variable].clear();
+        for (auto neighbor : bag) {
+            scores[neighbor] = GetScore(neighbors, neighbor, heuristic, maxSeparatorSize);
+            heap.emplace(scores[neighbor].first, scores[neighbor].second, neighbor);
+        }
+
+        positions[variable] = order.size();
+        order.push_back(variable);
+        bag.push_back(variable);
+        eliminationBags[variable] = std::move(bag);
+    }
+
+    // the parent of a bag is the bag of the neighbor that is eliminated first
+    std::vector<Variable> parentVariables(numberOfVariables + 1, 0);
+    for (auto variable : order) {
+        for (auto other : eliminationBags[variable]) {
+            if (other != variable && (parentVariables[variable] == 0 || positions[other] < positions[parentVariables[variable]])) {
+                parentVariables[variable] = other;
+            }
+        }
+    }
+
+    // the variable of a clause that is eliminated first has all other variables of the clause in its bag
+    std::vector<std::vector<size_t>> bagClauses(numberOfVariables + 1);
+    for (size_t i = 0; i < clauses.size(); i++) {
+        auto first = *std::min_element(clauses[i].begin(), clauses[i].end(), [&positions](auto l, auto r) {
+            return positions[ToVariable(l)] < positions[ToVariable(r)];
+        });
+        bagClauses[ToVariable(first)].push_back(i);
+    }
+    checkTimeLimit();
+
+    // merge small bags into their parents, the children come first in the elimination order
+    std::vector<Variable> mergedInto(numberOfVariables + 1, 0);
+    for (auto variable : order) {
+        auto& bag = eliminationBags[variable];
+        std::sort(bag.begin(), bag.end());
+        bag.erase(std::unique(bag.begin(), bag.end()), bag.end());
+
+        auto parent = parentVariables[variable];
+        if (parent != 0 && bagClauses[variable].size() < minClausesPerBag) {
+            auto& parentBag = eliminationBags[parent];
+            parentBag.insert(parentBag.end(), bag.begin(), bag.end());
+            auto& parentClauses = bagClauses[parent];
+            parentClauses.insert(parentClauses.end(), bagClauses[variable].begin(), bagClauses[variable].end());
+            bag.clear();
+            bagClauses[variable].clear();
+            mergedInto[variable] = parent;
+        }
+    }
+    auto findKept = [&mergedInto](Variable variable) {
+        while (mergedInto[variable] != 0) {
+            if (mergedInto[mergedInto[variable]] != 0) {
+                mergedInto[variable] = mergedInto[mergedInto[variable]];
+            }
+            variable = mergedInto[variable];
+        }
+        return variable;
+    };
+
+    TreeDecomposition decomposition;
+    std::vector<size_t> indices(numberOfVariables + 1, TreeDecomposition::None);
+    for (auto variable : order) {
+        if (mergedInto[variable] == 0) {
+            indices[variable] = decomposition.bags.size();
+            decomposition.bags.push_back(std::move(eliminationBags[variable]));
+            decomposition.clauses.push_back(std::move(bagClauses[variable]));
+        }
+    }
+    for (auto variable : order) {
+        if (mergedInto[variable] == 0) {
+            auto parent = parentVariables[variable];
+            decomposition.parents.push_back(parent == 0 ? TreeDecomposition::None : indices[findKept(parent)]);
+        }
+    }
+    return decomposition;
+}
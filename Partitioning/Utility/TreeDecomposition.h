@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Partitioning/DLLMakro.h"
+
+#include <functional>
+#include <limits>
+#include <optional>
+#include <vector>
+
+#include "Core/Types/Problem.h"
+
+enum class EliminationHeuristic : char {
+    /// <summary>
+    /// eliminate the variable with the fewest neighbors
+    /// </summary>
+    MinDegree,
+    /// <summary>
+    /// eliminate the variable whose elimination adds the fewest edges (ties: fewest neighbors)
+    /// </summary>
+    MinFill,
+};
+
+/// <summary>
+/// Tree decomposition of the primal graph (variables are connected if they occur in the same clause).
+/// Every clause belongs to one bag that contains all of its variables,
+/// a variable that occurs in two bags occurs in every bag on the path between them.
+/// Bags are ordered children first.
+/// </summary>
+struct PARTITIONINING_API TreeDecomposition {
+    static constexpr size_t None = std::numeric_limits<size_t>::max();
+
+    /// <summary>
+    /// sorted variables of each bag
+    /// </summary>
+    std::vector<std::vector<Variable>> bags;
+    /// <summary>
+    /// parent of each bag, None for the root of a tree (one per connected component)
+    /// </summary>
+    std::vector<size_t> parents;
+    /// <summary>
+    /// indices of the clauses of each bag
+    /// </summary>
+    std::vector<std::vector<size_t>> clauses;
+
+    size_t GetNumberOfBags() const
+    {
+        return bags.size();
+    }
+
+    /// <summary>
+    /// sorted variables the bag shares with its parent, only they connect the subtree of the bag with the rest
+    /// </summary>
+    /// <param name="bag"></param>
+    /// <returns></returns>
+    std::vector<Variable> GetSeparator(size_t bag) const;
+};
+
+/// <summary>
+/// Creates a tree decomposition by eliminating the variables one by one (the neighbors of an eliminated variable become a clique).
+/// Bags with fewer than minClausesPerBag clauses are merged into their parent, this keeps the separators.
+/// </summary>
+/// <param name="problem"></param>
+/// <param name="heuristic"></param>
+/// <param name="maxSeparatorSize">an elimination with more neighbors aborts the decomposition</param>
+/// <param name="minClausesPerBag"></param>
+/// <param name="checkTimeLimit">called regularly, may throw to abort</param>
+/// <returns>none if the separators would get larger than maxSeparatorSize</returns>
+PARTITIONINING_API std::optional<TreeDecomposition> DecomposeTree(const Problem& problem, EliminationHeuristic heuristic, size_t maxSeparatorSize, size_t minClausesPerBag, const std::function<void()>& checkTimeLimit);
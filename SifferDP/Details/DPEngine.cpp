@@ -0,0 +1,397 @@
+#include "SifferDP/stdafx.h"
+#include "DPEngine.h"
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
+DPEngine::DPEngine(Variable numberOfVariables, const std::vector<Clause>& originalClauses, const DPSettings& settings) :
+    settings(settings),
+    numberOfVariables(numberOfVariables),
+    occurrences(2 * (static_cast<size_t>(numberOfVariables) + 1)),
+    counts(2 * (static_cast<size_t>(numberOfVariables) + 1), 0),
+    values(static_cast<size_t>(numberOfVariables) + 1, 0),
+    eliminated(static_cast<size_t>(numberOfVariables) + 1, false),
+    isTouched(static_cast<size_t>(numberOfVariables) + 1, false)
+{
+    for (auto clause : originalClauses) {
+        std::sort(clause.begin(), clause.end(), LiteralLess);
+        clause.erase(std::unique(clause.begin(), clause.end()), clause.end());
+        auto tautology = std::adjacent_find(clause.begin(), clause.end(), [](auto l, auto r) {
+            return ToVariable(l) == ToVariable(r);
+        }) != clause.end();
+        if (!tautology) {
+            AddClause(std::move(clause));
+        }
+    }
+    clauseLimit = std::max(settings.minClauseLimit, static_cast<size_t>(settings.maxClauseGrowth * numberOfAlive));
+    eliminationOffsets.push_back(0);
+}
+
+std::optional<bool> DPEngine::Solve(OptionalTimeLimitMs timeLimit)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    Propagate();
+    UpdateQueue();
+    while (!conflict && numberOfAlive > 0) {
+        if (!HasRemaining(timeLimit, start)) {
+            return {};
+        }
+        auto variable = PopVariable();
+        if (!variable) {
+            throw std::runtime_error("no variable left to eliminate");
+        }
+        if (!Eliminate(variable.value())) {
+            // the clauses grow too much
+            return {};
+        }
+        UpdateQueue();
+    }
+    result = !conflict;
+    return result;
+}
+
+Assignment DPEngine::GetModel() const
+{
+    if (!result || !result.value()) {
+        throw std::runtime_error("no model, the problem is not known to be satisfiable");
+    }
+
+    Assignment model(numberOfVariables, VariableState::False);
+    for (Variable variable = FirstVariable; variable <= numberOfVariables; variable++) {
+        if (values[variable] != 0) {
+            model.SetState(variable, values[variable] > 0 ? VariableState::True : VariableState::False);
+        }
+    }
+
+    // the clauses of a variable only contain variables that were eliminated later or are fixed
+    for (auto i = eliminationOrder.size(); i-- > 0;) {
+        auto variable = eliminationOrder[i];
+        auto state = VariableState::False;
+        for (auto clause = eliminationOffsets[i]; clause < eliminationOffsets[i + 1]; clause++) {
+            const auto& literals = eliminatedClauses[clause];
+            auto needsPositive = std::find(literals.begin(), literals.end(), variable) != literals.end()
+                && std::none_of(literals.begin(), literals.end(), [&model, variable](auto literal) {
+                    return ToVariable(literal) != variable && model.IsSAT(literal);
+                });
+            if (needsPositive) {
+                state = VariableState::True;
+                break;
+            }
+        }
+        model.SetState(variable, state);
+    }
+    return model;
+}
+
+size_t DPEngine::GetNumberOfEliminations() const
+{
+    return numberOfEliminations;
+}
+
+size_t DPEngine::GetNumberOfResolvents() const
+{
+    return numberOfResolvents;
+}
+
+size_t DPEngine::GetNumberOfSubsumed() const
+{
+    return numberOfSubsumed;
+}
+
+size_t DPEngine::Index(Literal literal)
+{
+    return 2 * static_cast<size_t>(ToVariable(literal)) + (IsPositive(literal) ? 0 : 1);
+}
+
+bool DPEngine::LiteralLess(Literal l, Literal r)
+{
+    return Index(l) < Index(r);
+}
+
+void DPEngine::AddClause(Clause clause)
+{
+    if (conflict) {
+        return;
+    }
+
+    // remove falsified literals, drop satisfied clauses
+    size_t size = 0;
+    for (auto literal : clause) {
+        auto value = values[ToVariable(literal)];
+        if (value == 0) {
+            clause[size++] = literal;
+        } else if ((value > 0) == IsPositive(literal)) {
+            return;
+        }
+    }
+    clause.resize(size);
+
+    if (clause.empty()) {
+        conflict = true;
+        return;
+    }
+    if (clause.size() == 1) {
+        Assign(clause.front());
+        return;
+    }
+
+    auto id = clauses.size();
+    for (auto literal : clause) {
+        occurrences[Index(literal)].push_back(id);
+        counts[Index(literal)]++;
+        Touch(literal);
+    }
+    clauses.push_back(std::move(clause));
+    alive.push_back(true);
+    numberOfAlive++;
+}
+
+Clause DPEngine::RemoveClause(size_t clause)
+{
+    alive[clause] = false;
+    numberOfAlive--;
+    for (auto literal : clauses[clause]) {
+        counts[Index(literal)]--;
+        Touch(literal);
+    }
+    return std::move(clauses[clause]);
+}
+
+void DPEngine::Assign(Literal literal)
+{
+    signed char value = IsPositive(literal) ? 1 : -1;
+    auto& current = values[ToVariable(literal)];
+    if (current == value) {
+        return;
+    }
+    if (current != 0) {
+        conflict = true;
+        return;
+    }
+    current = value;
+    pendingUnits.push_back(literal);
+}
+
+void DPEngine::Propagate()
+{
+    while (!conflict && !pendingUnits.empty()) {
+        auto unit = pendingUnits.back();
+        pendingUnits.pop_back();
+
+        // satisfied clauses
+        auto& satisfied = occurrences[Index(unit)];
+        for (auto clause : satisfied) {
+            if (alive[clause]) {
+                RemoveClause(clause);
+            }
+        }
+        satisfied.clear();
+
+        // falsified literal
+        auto falsified = Negate(unit);
+        auto& shortened = occurrences[Index(falsified)];
+        for (auto clause : shortened) {
+            if (!alive[clause]) {
+                continue;
+            }
+            auto& literals = clauses[clause];
+            literals.erase(std::find(literals.begin(), literals.end(), falsified));
+            counts[Index(falsified)]--;
+            if (literals.size() == 1) {
+                auto implied = literals.front();
+                RemoveClause(clause);
+                Assign(implied);
+                if (conflict) {
+                    return;
+                }
+            }
+        }
+        shortened.clear();
+    }
+}
+
+bool DPEngine::Eliminate(Variable variable)
+{
+    numberOfEliminations++;
+
+    std::vector<size_t> positive;
+    for (auto clause : occurrences[Index(variable)]) {
+        if (alive[clause]) {
+            positive.push_back(clause);
+        }
+    }
+    std::vector<size_t> negative;
+    for (auto clause : occurrences[Index(Negate(variable))]) {
+        if (alive[clause]) {
+            negative.push_back(clause);
+        }
+    }
+
+    // all resolvents are built first, so the clauses are unchanged if a bound is exceeded
+    auto remaining = numberOfAlive - positive.size() - negative.size();
+    std::vector<Clause> resolvents;
+    for (auto p : positive) {
+        for (auto n : negative) {
+            auto resolvent = Resolve(clauses[p], clauses[n], variable);
+            if (!resolvent) {
+                continue;
+            }
+            if (settings.maxResolventLength > 0 && resolvent->size() > settings.maxResolventLength) {
+                return false;
+            }
+            resolvents.push_back(std::move(resolvent.value()));
+            if (remaining + resolvents.size() > clauseLimit) {
+                return false;
+            }
+        }
+    }
+
+    eliminated[variable] = true;
+    eliminationOrder.push_back(variable);
+    for (auto clause : positive) {
+        eliminatedClauses.push_back(RemoveClause(clause));
+    }
+    for (auto clause : negative) {
+        eliminatedClauses.push_back(RemoveClause(clause));
+    }
+    eliminationOffsets.push_back(eliminatedClauses.size());
+    occurrences[Index(variable)].clear();
+    occurrences[Index(Negate(variable))].clear();
+
+    numberOfResolvents += resolvents.size();
+    for (auto& resolvent : resolvents) {
+        if (conflict) {
+            break;
+        }
+        if (IsSubsumed(resolvent)) {
+            numberOfSubsumed++;
+            continue;
+        }
+        RemoveSubsumed(resolvent);
+        AddClause(std::move(resolvent));
+    }
+    Propagate();
+    return true;
+}
+
+std::optional<Clause> DPEngine::Resolve(const Clause& positive, const Clause& negative, Variable variable) const
+{
+    Clause resolvent;
+    resolvent.reserve(positive.size() + negative.size() - 2);
+    auto p = positive.begin();
+    auto n = negative.begin();
+    while (p != positive.end() || n != negative.end()) {
+        Literal next;
+        if (n == negative.end() || (p != positive.end() && LiteralLess(*p, *n))) {
+            next = *p++;
+        } else if (p == positive.end() || LiteralLess(*n, *p)) {
+            next = *n++;
+        } else {
+            // same literal
+            next = *p++;
+            n++;
+        }
+        if (ToVariable(next) == variable) {
+            continue;
+        }
+        // both literals of a variable are adjacent
+        if (!resolvent.empty() && ToVariable(resolvent.back()) == ToVariable(next)) {
+            return {};
+        }
+        resolvent.push_back(next);
+    }
+    return resolvent;
+}
+
+bool DPEngine::IsSubsumed(const Clause& clause)
+{
+    // a subsuming clause contains at least one of the literals
+    stamps.resize(clauses.size(), 0);
+    stamp++;
+    for (auto literal : clause) {
+        auto& list = occurrences[Index(literal)];
+        // drop removed clauses on the way
+        list.erase(std::remove_if(list.begin(), list.end(), [this](auto other) {
+            return !alive[other];
+        }), list.end());
+        for (auto other : list) {
+            if (stamps[other] == stamp) {
+                continue;
+            }
+            stamps[other] = stamp;
+            const auto& literals = clauses[other];
+            if (literals.size() <= clause.size() && std::includes(clause.begin(), clause.end(), literals.begin(), literals.end(), LiteralLess)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void DPEngine::RemoveSubsumed(const Clause& clause)
+{
+    // a subsumed clause contains all literals, the rarest one is enough to find it
+    auto rarest = *std::min_element(clause.begin(), clause.end(), [this](auto l, auto r) {
+        return counts[Index(l)] < counts[Index(r)];
+    });
+    for (auto other : occurrences[Index(rarest)]) {
+        if (!alive[other]) {
+            continue;
+        }
+        const auto& literals = clauses[other];
+        if (literals.size() >= clause.size() && std::includes(literals.begin(), literals.end(), clause.begin(), clause.end(), LiteralLess)) {
+            RemoveClause(other);
+            numberOfSubsumed++;
+        }
+    }
+}
+
+int64_t DPEngine::GetScore(Variable variable) const
+{
+    // growth of the number of clauses if all resolvents are kept
+    auto positive = static_cast<int64_t>(counts[Index(variable)]);
+    auto negative = static_cast<int64_t>(counts[Index(Negate(variable))]);
+    return positive * negative - positive - negative;
+}
+
+void DPEngine::Touch(Literal literal)
+{
+    auto variable = ToVariable(literal);
+    if (!isTouched[variable]) {
+        isTouched[variable] = true;
+        touched.push_back(variable);
+    }
+}
+
+void DPEngine::UpdateQueue()
+{
+    for (auto variable : touched) {
+        isTouched[variable] = false;
+        if (values[variable] == 0 && !eliminated[variable]) {
+            queue.emplace_back(GetScore(variable), variable);
+            std::push_heap(queue.begin(), queue.end(), std::greater<>());
+        }
+    }
+    touched.clear();
+}
+
+std::optional<Variable> DPEngine::PopVariable()
+{
+    while (!queue.empty()) {
+        std::pop_heap(queue.begin(), queue.end(), std::greater<>());
+        auto [score, variable] = queue.back();
+        queue.pop_back();
+        if (values[variable] != 0 || eliminated[variable] || score != GetScore(variable)) {
+            // outdated
+            continue;
+        }
+        if (counts[Index(variable)] + counts[Index(Negate(variable))] == 0) {
+            // does not occur anymore
+            continue;
+        }
+        return variable;
+    }
+    return {};
+}
@@ -0,0 +1,155 @@
+#pragma once
+
+#include "SifferDP/DLLMakro.h"
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "Core/Types/Assignment.h"
+#include "Core/Types/Clause.h"
+#include "Core/Types/Literal.h"
+#include "Core/Utility/TimeLimit.h"
+
+/// <summary>
+/// Bounds of the clause growth, the engine gives up instead of exceeding them.
+/// </summary>
+struct DPSettings {
+    /// <summary>
+    /// maximal number of clauses as a multiple of the initial number of clauses
+    /// </summary>
+    double maxClauseGrowth = 4;
+    /// <summary>
+    /// small problems may always grow to this number of clauses
+    /// </summary>
+    size_t minClauseLimit = 1000;
+    /// <summary>
+    /// a resolvent with more literals gives up, 0 for no limit
+    /// </summary>
+    size_t maxResolventLength = 0;
+};
+
+/// <summary>
+/// Davis-Putnam: decides a problem by eliminating its variables through resolution.
+/// The clauses are sorted literal vectors with an occurrence list per literal.
+/// Units are propagated eagerly, the variable whose resolvents add the fewest clauses is eliminated next,
+/// tautologies and resolvents subsumed by existing clauses are dropped,
+/// clauses subsumed by a resolvent are removed.
+/// The clauses of every eliminated variable are kept to rebuild a model in reverse elimination order.
+/// Not thread safe, use one engine per problem.
+/// </summary>
+class SIFFERDP_API DPEngine {
+private:
+    DPSettings settings;
+    size_t clauseLimit;
+    Variable numberOfVariables;
+    std::optional<bool> result;
+
+    std::vector<Clause> clauses;
+    std::vector<bool> alive;
+    size_t numberOfAlive = 0;
+    /// <summary>
+    /// clauses of each literal index (see Index), may contain removed clauses
+    /// </summary>
+    std::vector<std::vector<size_t>> occurrences;
+    /// <summary>
+    /// number of alive clauses of each literal index
+    /// </summary>
+    std::vector<size_t> counts;
+
+    /// <summary>
+    /// 1 true, -1 false, 0 open
+    /// </summary>
+    std::vector<signed char> values;
+    std::vector<bool> eliminated;
+    std::vector<Literal> pendingUnits;
+    bool conflict = false;
+
+    /// <summary>
+    /// min heap of (growth of the clauses if eliminated, variable), outdated entries are skipped
+    /// </summary>
+    std::vector<std::pair<int64_t, Variable>> queue;
+    std::vector<Variable> touched;
+    std::vector<bool> isTouched;
+
+    std::vector<size_t> stamps;
+    size_t stamp = 0;
+
+    /// <summary>
+    /// clauses of eliminationOrder[i] when it was eliminated are
+    /// eliminatedClauses[eliminationOffsets[i]] .. eliminatedClauses[eliminationOffsets[i + 1] - 1]
+    /// </summary>
+    std::vector<Variable> eliminationOrder;
+    std::vector<size_t> eliminationOffsets;
+    std::vector<Clause> eliminatedClauses;
+
+    size_t numberOfEliminations = 0;
+    size_t numberOfResolvents = 0;
+    size_t numberOfSubsumed = 0;
+
+public:
+    DPEngine(Variable numberOfVariables, const std::vector<Clause>& clauses, const DPSettings& settings = DPSettings());
+
+public:
+    /// <summary>
+    /// Eliminates all variables.
+    /// </summary>
+    /// <param name="timeLimit"></param>
+    /// <returns>true if satisfiable, false if unsatisfiable, none if the time limit or a bound of the settings was exceeded</returns>
+    std::optional<bool> Solve(OptionalTimeLimitMs timeLimit);
+
+    /// <summary>
+    /// Assigns the eliminated variables in reverse elimination order, each one satisfies the clauses it was eliminated from.
+    /// Linear in the size of the kept clauses. Variables that do not occur are false.
+    /// </summary>
+    /// <returns></returns>
+    Assignment GetModel() const;
+
+    size_t GetNumberOfEliminations() const;
+    size_t GetNumberOfResolvents() const;
+    /// <summary>
+    /// resolvents dropped and clauses removed because of subsumption
+    /// </summary>
+    /// <returns></returns>
+    size_t GetNumberOfSubsumed() const;
+
+private:
+    static size_t Index(Literal literal);
+    static bool LiteralLess(Literal l, Literal r);
+
+    /// <summary>
+    /// Adds a sorted clause without tautologies or duplicate literals.
+    /// Assigned literals are removed, units are assigned.
+    /// </summary>
+    /// <param name="clause"></param>
+    void AddClause(Clause clause);
+    /// <summary>
+    /// </summary>
+    /// <param name="clause"></param>
+    /// <returns>literals of the clause</returns>
+    Clause RemoveClause(size_t clause);
+    void Assign(Literal literal);
+    void Propagate();
+
+    /// <summary>
+    /// Replaces the clauses of the variable by their resolvents.
+    /// </summary>
+    /// <param name="variable"></param>
+    /// <returns>false if a bound was exceeded</returns>
+    bool Eliminate(Variable variable);
+    /// <summary>
+    /// resolvent of two sorted clauses on the variable
+    /// </summary>
+    /// <param name="positive"></param>
+    /// <param name="negative"></param>
+    /// <param name="variable"></param>
+    /// <returns>none if it is a tautology</returns>
+    std::optional<Clause> Resolve(const Clause& positive, const Clause& negative, Variable variable) const;
+    bool IsSubsumed(const Clause& clause);
+    void RemoveSubsumed(const Clause& clause);
+
+    int64_t GetScore(Variable variable) const;
+    void Touch(Literal literal);
+    void UpdateQueue();
+    std::optional<Variable> PopVariable();
+};
@@ -5,9 +5,20 @@
 #include "SolverPortfolio.h"
 
 #include <algorithm>
+#include <stdexcept>
+
+const std::vector<std::string>& SolverPortfolio::GetSolverNames()
+{
+    static const std::vector<std::string> names = {"CryptoMiniSat", "Gurobi", "LocalSolver"};
+    return names;
+}
 
 Solution SolverPortfolio::Solve(const Problem& problem, OptionalTimeLimitMs timeLimit)
 {
+    if (selector) {
+        return SolveScheduled(problem, selector->Select(CostModel::GetFeatures(problem), timeLimit), timeLimit);
+    }
+
     if (!timeLimit) {
         return SolveUnlimited(problem);
     }
@@ -51,3 +62,47 @@ Solution SolverPortfolio::SolveUnlimited(const Problem& problem)
     // CryptoMiniSat
     return cms.Solve(problem, {});
 }
+
+void SolverPortfolio::SetSelector(std::shared_ptr<const SolverSelector> selector)
+{
+    if (selector) {
+        for (const auto& name : selector->GetSolvers()) {
+            GetSolver(name);
+        }
+    }
+    this->selector = selector;
+}
+
+Solution SolverPortfolio::SolveScheduled(const Problem& problem, const std::vector<ScheduleStep>& schedule, OptionalTimeLimitMs timeLimit)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    for (size_t step = 0; step < schedule.size(); step++) {
+        auto last = step + 1 == schedule.size();
+        auto stepTimeLimit = GetRemaining(timeLimit, start);
+        if (!last && schedule[step].timeLimit && (!stepTimeLimit || schedule[step].timeLimit < stepTimeLimit)) {
+            stepTimeLimit = schedule[step].timeLimit;
+        }
+
+        auto result = GetSolver(schedule[step].solver).Solve(problem, stepTimeLimit);
+        if (result.first != SolvingResult::Undefined || last) {
+            return result;
+        }
+    }
+    return {SolvingResult::Undefined, {}};
+}
+
+SATSolver& SolverPortfolio::GetSolver(const std::string& name)
+{
+    const auto& names = GetSolverNames();
+    if (name == names[0]) {
+        return cms;
+    }
+    if (name == names[1]) {
+        return gurobi;
+    }
+    if (name == names[2]) {
+        return localSolver;
+    }
+    throw std::invalid_argument("unknown solver in the portfolio: " + name);
+}
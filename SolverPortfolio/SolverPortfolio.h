@@ -2,7 +2,12 @@
 
 #include "DLLMakro.h"
 
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "Core/Interfaces/SATSolver.h"
+#include "Core/Utility/SolverSelector.h"
 #include "CryptoMiniSat/CryptoMiniSatSolver.h"
 #include "Gurobi/GurobiSolver.h"
 #include "LocalSolverSat/LocalSolverSat.h"
@@ -12,10 +17,33 @@ private:
     CryptoMiniSatSolver cms;
     GurobiSolver gurobi;
     LocalSolverSat localSolver;
+    std::shared_ptr<const SolverSelector> selector;
+
+public:
+    /// <summary>
+    /// names of the solvers in the csv of Benchmark, a selector may only use these
+    /// </summary>
+    /// <returns></returns>
+    static const std::vector<std::string>& GetSolverNames();
 
 public:
     virtual Solution Solve(const Problem& problem, OptionalTimeLimitMs timeLimit) override;
 
+    /// <summary>
+    /// Lets the selector choose the solver order and time split per instance.
+    /// </summary>
+    /// <param name="selector">nullptr restores the fixed schedule</param>
+    void SetSelector(std::shared_ptr<const SolverSelector> selector);
+
 protected:
     virtual Solution SolveUnlimited(const Problem& problem);
+    /// <summary>
+    /// Runs the steps in order until one decides the problem, the last step gets the remaining time.
+    /// </summary>
+    /// <param name="problem"></param>
+    /// <param name="schedule"></param>
+    /// <param name="timeLimit"></param>
+    /// <returns></returns>
+    virtual Solution SolveScheduled(const Problem& problem, const std::vector<ScheduleStep>& schedule, OptionalTimeLimitMs timeLimit);
+    SATSolver& GetSolver(const std::string& name);
 };
\ No newline at end of file